@@ -1,93 +1,147 @@
 #include "Account.h"
 #include <stdexcept>
-#include <iostream>
-#include "Transaction.h"
+#include "Logger.h"
 
 // Default constructor
 Account::Account()
-    : accountNo(""),
-      ownerId(""),
-      balance(0.0),
-      lastInterestApplied(Timestamp::now()) {
+    : accountHandle(StringInterner::accountNumbers().intern("")),
+      ownerHandle(StringInterner::ownerIds().intern("")),
+      balance(),
+      lastInterestApplied(Timestamp::now()),
+      historyHead(0),
+      archivedHistoryCount(0),
+      dirty(true) {
 }
 
 // Parameterized constructor
-Account::Account(const std::string& accountNo, const std::string& ownerId, double balance)
-    : accountNo(accountNo),
-      ownerId(ownerId),
+Account::Account(const std::string& accountNo, const std::string& ownerId, Money balance)
+    : accountHandle(StringInterner::accountNumbers().intern(accountNo)),
+      ownerHandle(StringInterner::ownerIds().intern(ownerId)),
       balance(balance),
-      lastInterestApplied(Timestamp::now()) {
+      lastInterestApplied(Timestamp::now()),
+      historyHead(0),
+      archivedHistoryCount(0),
+      dirty(true) {
 
-    if (balance < 0) {
+    if (balance.isNegative()) {
         throw std::invalid_argument("Initial balance cannot be negative");
     }
 }
 
 // Getters
-std::string Account::getAccountNo() const {
-    return accountNo;
+const std::string& Account::getAccountNo() const {
+    return StringInterner::accountNumbers().view(accountHandle);
 }
 
-std::string Account::getOwnerId() const {
-    return ownerId;
+const std::string& Account::getOwnerId() const {
+    return StringInterner::ownerIds().view(ownerHandle);
 }
 
-double Account::getBalance() const {
+StringInterner::Handle Account::getAccountHandle() const {
+    return accountHandle;
+}
+
+StringInterner::Handle Account::getOwnerHandle() const {
+    return ownerHandle;
+}
+
+Money Account::getBalance() const {
     return balance;
 }
 
+Timestamp Account::getLastInterestApplied() const {
+    return lastInterestApplied;
+}
+
+// Per-account lock
+std::mutex& Account::getMutex() const {
+    return mutex;
+}
+
 // Set balance - use with caution, mainly for internal operations
-void Account::setBalance(double amount) {
-    if (amount < 0) {
+void Account::setBalance(Money amount) {
+    if (amount.isNegative()) {
         throw std::invalid_argument("Balance cannot be negative");
     }
     balance = amount;
+    markDirty();
+}
+
+// Restore balance from snapshot/journal - no validation, may be negative
+void Account::restoreBalance(Money amount) {
+    balance = amount;
+    markDirty();
+}
+
+// Restore accrual time from snapshot
+void Account::restoreLastInterestApplied(const Timestamp& lastApplied) {
+    lastInterestApplied = lastApplied;
+    markDirty();
+}
+
+// Dirty tracking
+bool Account::isDirty() const {
+    return dirty.load(std::memory_order_acquire);
+}
+
+void Account::clearDirty() {
+    dirty.store(false, std::memory_order_release);
+}
+
+void Account::markDirty() {
+    dirty.store(true, std::memory_order_release);
 }
 
 // Deposit money into account
-bool Account::deposit(double amount) {
-    if (amount <= 0) {
-        std::cerr << "Deposit amount must be positive" << std::endl;
+bool Account::deposit(Money amount) {
+    if (!amount.isPositive()) {
+        LOG_DEBUG("Deposit amount must be positive");
         return false;
     }
 
     balance += amount;
+    markDirty();
     // TODO: Create and record deposit transaction
     return true;
 }
 
 // Withdraw money from account
-bool Account::withdraw(double amount) {
-    if (amount <= 0) {
-        std::cerr << "Withdrawal amount must be positive" << std::endl;
+bool Account::withdraw(Money amount) {
+    if (!amount.isPositive()) {
+        LOG_DEBUG("Withdrawal amount must be positive");
         return false;
     }
 
     if (amount > balance) {
-        std::cerr << "Insufficient funds for Withdrawal" << std::endl;
+        LOG_DEBUG("Insufficient funds for Withdrawal");
         return false;
     }
 
     balance -= amount;
+    markDirty();
     // TODO: Create and record withdrawal transaction
     return true;
 }
 
 // Transfer money to another account
-bool Account::transferTo(Account& target, double amount) {
-    if (amount <= 0) {
-        std::cerr << "Transfer amount must be positive" << std::endl;
+bool Account::transferTo(Account& target, Money amount) {
+    if (!amount.isPositive()) {
+        LOG_DEBUG("Transfer amount must be positive");
         return false;
     }
 
     if (amount > balance) {
-        std::cerr << "Insufficient funds for transfer" << std::endl;
+        LOG_DEBUG("Insufficient funds for transfer");
         return false;
     }
 
-    // Perform the transfer
+    // Perform the transfer; the credit is computed first so an overflow
+    // leaves both balances untouched
+    Money targetBalance = target.balance + amount;
     balance -= amount;
-    target.balance += amount;
+    target.balance = targetBalance;
+    markDirty();
+    target.markDirty();
 
     // TODO: Create and record transfer transactions for both accounts
     return true;
@@ -95,8 +149,8 @@ bool Account::transferTo(Account& target, double amount) {
 
 // Close account
 bool Account::close() {
-    if (balance > 0) {
-        std::cerr << "Cannot close account with positive balance. Please withdraw all funds first." << std::endl;
+    if (balance.isPositive()) {
+        LOG_DEBUG("Cannot close account with positive balance. Please withdraw all funds first.");
         return false;
     }
 
@@ -104,20 +158,55 @@ bool Account::close() {
     return true;
 }
 
-// Destructor - clean up transaction history
+// Destructor
 Account::~Account() {
-    for (Transaction* t : history) {
-         delete t;
-    }
-    history.clear();
 }
 
-// Protected method to record transactions
-void Account::record(Transaction* transaction) {
-    history.push_back(transaction);
+// Append a posting to the history
+void Account::recordHistory(const HistoryEntry& entry) {
+    history.push_back(entry);
+    if (lastHistoryId < entry.id) {
+        lastHistoryId = entry.id;
+    }
+    markDirty();
 }
 
-// Get transaction history
-const std::vector<Transaction*>& Account::getHistory() const {
+// Get unsaved transaction history
+const std::vector<HistoryEntry>& Account::getHistory() const {
     return history;
-}
\ No newline at end of file
+}
+
+std::uint64_t Account::getHistoryHead() const {
+    return historyHead;
+}
+
+std::uint32_t Account::getArchivedHistoryCount() const {
+    return archivedHistoryCount;
+}
+
+size_t Account::getHistoryCount() const {
+    return archivedHistoryCount + history.size();
+}
+
+TransactionId Account::getLastHistoryId() const {
+    return lastHistoryId;
+}
+
+// Entries written by a save leave the in-memory list
+bool Account::markHistoryArchived(std::uint64_t stagedFrom, std::uint64_t head, size_t savedCount) {
+    if (historyHead != stagedFrom || savedCount > history.size()) {
+        return false;
+    }
+    history.erase(history.begin(), history.begin() + static_cast<std::ptrdiff_t>(savedCount));
+    historyHead = head;
+    archivedHistoryCount += static_cast<std::uint32_t>(savedCount);
+    return true;
+}
+
+// Restore history position from snapshot
+void Account::restoreHistory(std::uint64_t head, std::uint32_t count, TransactionId lastId) {
+    historyHead = head;
+    archivedHistoryCount = count;
+    lastHistoryId = lastId;
+    TransactionIdGenerator::observe(lastId);
+}
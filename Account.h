@@ -1,11 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <vector>
+#include <mutex>
+#include "HistoryEntry.h"
+#include "Money.h"
 #include "Timestamp.h"
-
-
-class Transaction;
+#include "StringInterner.h"
 
 /**
  * Abstract base class for all account types
@@ -13,35 +15,71 @@ class Transaction;
  */
 class Account {
 protected:
-    std::string accountNo;
-    std::string ownerId;
-    double balance;
-    std::vector<Transaction*> history;
+    // Interned identifiers (see StringInterner)
+    StringInterner::Handle accountHandle;
+    StringInterner::Handle ownerHandle;
+    Money balance;
     Timestamp lastInterestApplied;
 
-    // Protected method to record transactions
-    void record(Transaction* transaction);
+    // Postings recorded since the last save; older ones are in the history
+    // archive, as a block chain ending at historyHead (see HistoryArchive)
+    std::vector<HistoryEntry> history;
+    std::uint64_t historyHead;
+    std::uint32_t archivedHistoryCount;
+    TransactionId lastHistoryId;        // Newest entry, saved or not
+
+    // Per-account lock serializing balance changes across threads
+    mutable std::mutex mutex;
+
+    // Changed since the last checkpoint (see DataPersistence::checkpointAccounts)
+    std::atomic<bool> dirty;
+
+    // Flag the account for the next incremental save
+    void markDirty();
 
 public:
     // Constructors
     Account();
-    Account(const std::string& accountNo, const std::string& ownerId, double balance);
+    Account(const std::string& accountNo, const std::string& ownerId, Money balance);
 
     // Virtual destructor for proper cleanup
     virtual ~Account();
 
+    Account(const Account&) = delete;
+    Account& operator=(const Account&) = delete;
+
     // Getters
-    std::string getAccountNo() const;
-    std::string getOwnerId() const;
-    double getBalance() const;
+    const std::string& getAccountNo() const;
+    const std::string& getOwnerId() const;
+    StringInterner::Handle getAccountHandle() const;
+    StringInterner::Handle getOwnerHandle() const;
+    Money getBalance() const;
+    Timestamp getLastInterestApplied() const;
+
+    // Lock guarding this account's balance; the balance operations below
+    // expect the caller to hold it (transactions take it in execute/undo)
+    std::mutex& getMutex() const;
 
     // Balance manipulation
-    void setBalance(double amount);
+    void setBalance(Money amount);
+
+    // Overwrite the balance from persisted state (recovery only)
+    // Unlike setBalance this accepts overdrawn (negative) balances
+    void restoreBalance(Money amount);
+
+    // Overwrite the last interest accrual time from persisted state
+    void restoreLastInterestApplied(const Timestamp& lastApplied);
+
+    // Dirty tracking: set by every state change, cleared once the account
+    // has been written to a snapshot or delta
+    bool isDirty() const;
+    void clearDirty();
 
     // Core banking operations
-    virtual bool deposit(double amount);
-    virtual bool withdraw(double amount);
-    virtual bool transferTo(Account& target, double amount);
+    virtual bool deposit(Money amount);
+    virtual bool withdraw(Money amount);
+    // Caller must hold the locks of both accounts
+    virtual bool transferTo(Account& target, Money amount);
 
     // Interest application - simplified for now, can add InterestPolicy later
     virtual bool applyInterest(const Timestamp& now) = 0;
@@ -49,8 +87,27 @@ public:
     // Account management
     virtual bool close();
 
-    // Transaction history
-    const std::vector<Transaction*>& getHistory() const;
+    // Transaction history (caller holds the account lock)
+    // Append a posting; called by transactions and interest crediting
+    void recordHistory(const HistoryEntry& entry);
+
+    // Entries not yet saved to the archive, oldest first
+    const std::vector<HistoryEntry>& getHistory() const;
+
+    // Saved part of the history: archive chain head and entry count
+    std::uint64_t getHistoryHead() const;
+    std::uint32_t getArchivedHistoryCount() const;
+    size_t getHistoryCount() const;
+    TransactionId getLastHistoryId() const;
+
+    // The first savedCount unsaved entries, staged after the block at
+    // stagedFrom, now end the chain at head. Ignored (false) if the chain
+    // has moved on since they were staged - another save or spill already
+    // archived them
+    bool markHistoryArchived(std::uint64_t stagedFrom, std::uint64_t head, size_t savedCount);
+
+    // Restore the saved history position from persisted state
+    void restoreHistory(std::uint64_t head, std::uint32_t count, TransactionId lastId);
 
     // Pure virtual method to get account type (for polymorphism)
     virtual std::string getAccountType() const = 0;
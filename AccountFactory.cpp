@@ -1,13 +1,14 @@
 #include "AccountFactory.h"
 #include "AccountRepository.h"
 #include "SavingsAccount.h"
+#include "TFSAAccount.h"
 #include "ChequingAccount.h"
 #include <sstream>
 #include <iomanip>
 #include <stdexcept>
 
 // Initialize static counter
-int AccountFactory::accountCounter = 1000;
+std::atomic<int> AccountFactory::accountCounter{1000};
 
 // Constructor
 AccountFactory::AccountFactory() {
@@ -66,19 +67,21 @@ void AccountFactory::updateCounterFromLoadedAccounts(const AccountRepository& re
         }
     }
 
-    if (maxNumeric >= accountCounter) {
-        accountCounter = maxNumeric + 1;
+    int current = accountCounter.load();
+    while (maxNumeric >= current &&
+           !accountCounter.compare_exchange_weak(current, maxNumeric + 1)) {
+        // current reloaded by compare_exchange_weak; retry
     }
 }
 
-// Create account with default balance (0.0)
+// Create account with default balance (0.00)
 Account* AccountFactory::create(AccountType type, const std::string& ownerId) {
-    return create(type, ownerId, 0.0);
+    return create(type, ownerId, Money());
 }
 
 // Create account with specified initial balance
 Account* AccountFactory::create(AccountType type, const std::string& ownerId,
-                                double initialBalance) {
+                                Money initialBalance) {
     std::string accountNo = generateAccountNumber(type);
 
     switch (type) {
@@ -88,17 +91,41 @@ Account* AccountFactory::create(AccountType type, const std::string& ownerId,
 
         case AccountType::Chequing:
             // Create chequing account with default $500 overdraft
-            return new ChequingAccount(accountNo, ownerId, initialBalance, 500.0);
+            return new ChequingAccount(accountNo, ownerId, initialBalance, Money::fromUnits(500));
 
         case AccountType::TFSA:
-            // TFSA not implemented yet - throw error for now
-            throw std::runtime_error("TFSA account type not yet implemented");
+            // TFSA earns the savings rate
+            return new TFSAAccount(accountNo, ownerId, initialBalance, 0.02);
 
         default:
             throw std::invalid_argument("Unknown account type");
     }
 }
 
+// Rebuild an account from persisted state
+Account* AccountFactory::restore(AccountType type, const std::string& accountNo,
+                                 const std::string& ownerId, Money balance,
+                                 Money overdraftLimit, double interestRate) {
+    Account* account = nullptr;
+    switch (type) {
+        case AccountType::Savings:
+            account = new SavingsAccount(accountNo, ownerId, Money(), interestRate);
+            break;
+        case AccountType::TFSA:
+            account = new TFSAAccount(accountNo, ownerId, Money(), interestRate);
+            break;
+        case AccountType::Chequing:
+            account = new ChequingAccount(accountNo, ownerId, Money(), overdraftLimit);
+            break;
+        default:
+            return nullptr;
+    }
+
+    // Overdrawn chequing balances are negative; bypass the ctor check
+    account->restoreBalance(balance);
+    return account;
+}
+
 // Convert AccountType to string
 std::string AccountFactory::accountTypeToString(AccountType type) {
     switch (type) {
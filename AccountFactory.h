@@ -2,6 +2,7 @@
 
 #include <string>
 #include <memory>
+#include <atomic>
 #include "AccountType.h"
 #include "Account.h"
 
@@ -13,7 +14,7 @@ class AccountRepository;
  */
 class AccountFactory {
 private:
-    static int accountCounter;  // Static counter for generating unique account numbers
+    static std::atomic<int> accountCounter;  // Static counter for generating unique account numbers
 
     // Generate unique account number based on type
     static std::string generateAccountNumber(AccountType type);
@@ -29,7 +30,13 @@ public:
     Account* create(AccountType type, const std::string& ownerId);
 
     // Overloaded create with initial balance
-    Account* create(AccountType type, const std::string& ownerId, double initialBalance);
+    Account* create(AccountType type, const std::string& ownerId, Money initialBalance);
+
+    // Rebuild an account from persisted state (snapshot, delta, import)
+    // Balances may be negative (overdrawn chequing). Returns nullptr for
+    // account types without an implementation.
+    Account* restore(AccountType type, const std::string& accountNo, const std::string& ownerId,
+                     Money balance, Money overdraftLimit, double interestRate);
 
     // Helper method to convert AccountType to string
     static std::string accountTypeToString(AccountType type);
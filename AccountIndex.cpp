@@ -0,0 +1,255 @@
+#include "AccountIndex.h"
+#include "Account.h"
+#include <cstring>
+#include <functional>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BANK_INDEX_SSE2 1
+#endif
+
+namespace {
+
+// Control byte values; full slots hold a 7-bit hash tag (0..127)
+constexpr std::int8_t CTRL_EMPTY = -128;
+constexpr std::int8_t CTRL_DELETED = -2;
+
+// Bit i set for each byte of a 16-byte control group matching a condition
+class Group {
+private:
+#ifdef BANK_INDEX_SSE2
+    __m128i bytes;
+#else
+    const std::int8_t* bytes;
+#endif
+
+public:
+    explicit Group(const std::int8_t* position) {
+#ifdef BANK_INDEX_SSE2
+        bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position));
+#else
+        bytes = position;
+#endif
+    }
+
+    std::uint32_t match(std::int8_t tag) const {
+#ifdef BANK_INDEX_SSE2
+        return static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(tag))));
+#else
+        std::uint32_t mask = 0;
+        for (size_t i = 0; i < AccountIndex::GROUP_WIDTH; ++i) {
+            mask |= static_cast<std::uint32_t>(bytes[i] == tag) << i;
+        }
+        return mask;
+#endif
+    }
+
+    std::uint32_t matchEmpty() const {
+        return match(CTRL_EMPTY);
+    }
+
+    // Empty and deleted are the only negative control values
+    std::uint32_t matchEmptyOrDeleted() const {
+#ifdef BANK_INDEX_SSE2
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(bytes));
+#else
+        std::uint32_t mask = 0;
+        for (size_t i = 0; i < AccountIndex::GROUP_WIDTH; ++i) {
+            mask |= static_cast<std::uint32_t>(bytes[i] < 0) << i;
+        }
+        return mask;
+#endif
+    }
+};
+
+inline unsigned lowestBit(std::uint32_t mask) {
+    return static_cast<unsigned>(__builtin_ctz(mask));
+}
+
+// Mix both key words so every character affects the tag and group bits
+inline std::uint64_t mixKey(std::uint64_t low, std::uint64_t high) {
+    std::uint64_t h = low * 0x9E3779B97F4A7C15ULL + high;
+    h ^= h >> 29;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 32;
+    return h;
+}
+
+// Hash tag stored in the control byte
+inline std::int8_t tagOf(std::uint64_t hash) {
+    return static_cast<std::int8_t>(hash & 0x7F);
+}
+
+// Probe sequence start (group index bits)
+inline size_t groupOf(std::uint64_t hash) {
+    return static_cast<size_t>(hash >> 7);
+}
+
+// Maximum live + deleted entries for a capacity (7/8 load factor)
+inline size_t maxLoad(size_t capacity) {
+    return capacity - capacity / 8;
+}
+
+}  // namespace
+
+// Encode an account number
+AccountIndex::Key::Key(const std::string& accountNo) : text(&accountNo) {
+    unsigned char buffer[16] = {};
+    inlineKey = accountNo.size() <= INLINE_CHARS;
+    if (inlineKey) {
+        std::memcpy(buffer, accountNo.data(), accountNo.size());
+        buffer[15] = static_cast<unsigned char>(accountNo.size());
+    } else {
+        std::uint64_t stringHash = std::hash<std::string>{}(accountNo);
+        std::uint32_t length = static_cast<std::uint32_t>(accountNo.size());
+        std::memcpy(buffer, &stringHash, sizeof(stringHash));
+        std::memcpy(buffer + 8, &length, sizeof(length));
+        buffer[15] = LONG_KEY;
+    }
+    std::memcpy(&low, buffer, sizeof(low));
+    std::memcpy(&high, buffer + 8, sizeof(high));
+    hashValue = mixKey(low, high);
+}
+
+// Constructor
+AccountIndex::AccountIndex() : capacity(0), count(0), growthLeft(0) {
+}
+
+// Compare a stored slot with a key
+bool AccountIndex::matches(const Slot& slot, const Key& key) {
+    if (slot.low != key.low || slot.high != key.high) {
+        return false;
+    }
+    return key.inlineKey || slot.value->getAccountNo() == *key.text;
+}
+
+// Probe groups in triangular order until the key or an empty byte is seen
+size_t AccountIndex::findSlot(const Key& key) const {
+    if (capacity == 0) {
+        return capacity;
+    }
+
+    const size_t groupMask = capacity / GROUP_WIDTH - 1;
+    const std::int8_t tag = tagOf(key.hashValue);
+    size_t group = groupOf(key.hashValue) & groupMask;
+
+    for (size_t step = 1;; ++step) {
+        const size_t base = group * GROUP_WIDTH;
+        Group controlGroup(&control[base]);
+
+        for (std::uint32_t mask = controlGroup.match(tag); mask != 0; mask &= mask - 1) {
+            size_t index = base + lowestBit(mask);
+            if (matches(slots[index], key)) {
+                return index;
+            }
+        }
+        if (controlGroup.matchEmpty() != 0) {
+            return capacity;
+        }
+        group = (group + step) & groupMask;
+    }
+}
+
+// First reusable slot along the probe sequence (the table is never full)
+size_t AccountIndex::findInsertSlot(std::uint64_t hash) const {
+    const size_t groupMask = capacity / GROUP_WIDTH - 1;
+    size_t group = groupOf(hash) & groupMask;
+
+    for (size_t step = 1;; ++step) {
+        const size_t base = group * GROUP_WIDTH;
+        std::uint32_t mask = Group(&control[base]).matchEmptyOrDeleted();
+        if (mask != 0) {
+            return base + lowestBit(mask);
+        }
+        group = (group + step) & groupMask;
+    }
+}
+
+// Rebuild the table
+void AccountIndex::rehash(size_t newCapacity) {
+    std::unique_ptr<std::int8_t[]> oldControl = std::move(control);
+    std::unique_ptr<Slot[]> oldSlots = std::move(slots);
+    size_t oldCapacity = capacity;
+
+    control.reset(new std::int8_t[newCapacity]);
+    std::memset(control.get(), CTRL_EMPTY, newCapacity);
+    slots.reset(new Slot[newCapacity]);
+    capacity = newCapacity;
+
+    for (size_t i = 0; i < oldCapacity; ++i) {
+        if (oldControl[i] < 0) {
+            continue;
+        }
+        // Recompute the hash from the stored key words
+        const Slot& slot = oldSlots[i];
+        std::uint64_t h = mixKey(slot.low, slot.high);
+
+        size_t index = findInsertSlot(h);
+        control[index] = tagOf(h);
+        slots[index] = slot;
+    }
+    growthLeft = maxLoad(capacity) - count;
+}
+
+// Look up an account
+Account* AccountIndex::find(const Key& key) const {
+    size_t index = findSlot(key);
+    return index == capacity ? nullptr : slots[index].value;
+}
+
+// Add or replace an account
+Account* AccountIndex::insert(const Key& key, Account* account) {
+    size_t index = findSlot(key);
+    if (index != capacity) {
+        Account* previous = slots[index].value;
+        slots[index].value = account;
+        return previous;
+    }
+
+    if (growthLeft == 0) {
+        // Mostly tombstones: clean up in place; otherwise grow
+        if (capacity != 0 && count < maxLoad(capacity) / 2) {
+            rehash(capacity);
+        } else {
+            rehash(capacity == 0 ? GROUP_WIDTH : capacity * 2);
+        }
+    }
+
+    index = findInsertSlot(key.hashValue);
+    if (control[index] == CTRL_EMPTY) {
+        --growthLeft;
+    }
+    control[index] = tagOf(key.hashValue);
+    slots[index] = Slot{key.low, key.high, account};
+    ++count;
+    return nullptr;
+}
+
+// Remove an account
+Account* AccountIndex::erase(const Key& key) {
+    size_t index = findSlot(key);
+    if (index == capacity) {
+        return nullptr;
+    }
+
+    // Probes for other keys stop at a group that already has an empty byte,
+    // so the slot can become empty again; otherwise leave a tombstone
+    size_t base = index - index % GROUP_WIDTH;
+    if (Group(&control[base]).matchEmpty() != 0) {
+        control[index] = CTRL_EMPTY;
+        ++growthLeft;
+    } else {
+        control[index] = CTRL_DELETED;
+    }
+    --count;
+    return slots[index].value;
+}
+
+// Release the table
+void AccountIndex::clear() {
+    control.reset();
+    slots.reset();
+    capacity = 0;
+    count = 0;
+    growthLeft = 0;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class Account;
+
+/**
+ * AccountIndex - Flat open-addressing hash table from account number to Account*
+ *
+ * Layout follows the Swiss table design: a byte of control metadata per
+ * slot (empty, deleted, or the low 7 bits of the key hash) stored apart
+ * from the slots, probed 16 bytes at a time. With SSE2 a whole group is
+ * compared against the hash tag in one instruction, so a lookup normally
+ * touches one control group and one slot, with no node pointers to chase.
+ *
+ * Keys are stored in a compact 16-byte encoding: account numbers of up to
+ * 15 characters (every number AccountFactory generates) are packed inline
+ * and compared as two integers. Longer numbers are stored as a hash and
+ * confirmed against the Account itself.
+ *
+ * Not thread-safe; AccountRepository guards each shard's index with the
+ * shard lock.
+ */
+class AccountIndex {
+public:
+    static constexpr size_t GROUP_WIDTH = 16;
+
+    // Encoded account number plus its hash; refers to the source string
+    class Key {
+    private:
+        friend class AccountIndex;
+
+        // Inline keys: characters 0-14 followed by the length byte
+        // Long keys: string hash and length followed by LONG_KEY
+        std::uint64_t low;
+        std::uint64_t high;
+        std::uint64_t hashValue;
+        const std::string* text;
+        bool inlineKey;
+
+        static constexpr unsigned char LONG_KEY = 0xFF;
+        static constexpr size_t INLINE_CHARS = 15;
+
+    public:
+        explicit Key(const std::string& accountNo);
+
+        std::uint64_t hash() const { return hashValue; }
+    };
+
+private:
+    struct Slot {
+        std::uint64_t low;
+        std::uint64_t high;
+        Account* value;
+    };
+
+    std::unique_ptr<std::int8_t[]> control;  // One byte per slot
+    std::unique_ptr<Slot[]> slots;
+    size_t capacity;       // Slot count: zero or a power-of-two multiple of GROUP_WIDTH
+    size_t count;          // Live entries
+    size_t growthLeft;     // Inserts into empty slots before a rehash
+
+    static bool matches(const Slot& slot, const Key& key);
+
+    // Slot holding key, or capacity if absent
+    size_t findSlot(const Key& key) const;
+
+    // First empty or deleted slot on key's probe sequence
+    size_t findInsertSlot(std::uint64_t hash) const;
+
+    // Rebuild into newCapacity slots, dropping tombstones
+    void rehash(size_t newCapacity);
+
+public:
+    AccountIndex();
+
+    AccountIndex(const AccountIndex&) = delete;
+    AccountIndex& operator=(const AccountIndex&) = delete;
+
+    // Account stored under key (nullptr if absent)
+    Account* find(const Key& key) const;
+
+    // Add or replace; returns the account previously stored (nullptr if new)
+    Account* insert(const Key& key, Account* account);
+
+    // Remove key; returns the account that was stored (nullptr if absent)
+    Account* erase(const Key& key);
+
+    // Visit every stored account (in no particular order)
+    template <typename F>
+    void forEach(F&& visit) const {
+        for (size_t i = 0; i < capacity; ++i) {
+            if (control[i] >= 0) {
+                visit(slots[i].value);
+            }
+        }
+    }
+
+    size_t size() const { return count; }
+
+    // Drop all entries and release the table
+    void clear();
+};
@@ -1,10 +1,14 @@
 #include "AccountRepository.h"
 #include "ChequingAccount.h"
-#include <iostream>
+#include <algorithm>
+#include <functional>
+#include "Logger.h"
+#include <mutex>
+#include <string_view>
+#include <utility>
 
 // Constructor
-AccountRepository::AccountRepository() {
-    // Nothing special needed
+AccountRepository::AccountRepository() : accountCount(0) {
 }
 
 // Destructor - cleanup all accounts
@@ -12,132 +16,338 @@ AccountRepository::~AccountRepository() {
     clear();
 }
 
+// Select shard from the top bits of the account number hash
+AccountRepository::Shard& AccountRepository::shardFor(const AccountIndex::Key& key) {
+    return shards[(key.hash() >> 58) & (SHARD_COUNT - 1)];
+}
+
+const AccountRepository::Shard& AccountRepository::shardFor(const AccountIndex::Key& key) const {
+    return shards[(key.hash() >> 58) & (SHARD_COUNT - 1)];
+}
+
+// Select owner index shard from the (dense) owner handle
+AccountRepository::OwnerShard& AccountRepository::ownerShardFor(StringInterner::Handle owner) {
+    return ownerShards[owner & (SHARD_COUNT - 1)];
+}
+
+// Orders account handles by their account number
+static bool accountNoLess(StringInterner::Handle a, StringInterner::Handle b) {
+    const StringInterner& accountNumbers = StringInterner::accountNumbers();
+    return accountNumbers.view(a) < accountNumbers.view(b);
+}
+
+// Add an account to its owner's sorted list
+void AccountRepository::indexOwner(StringInterner::Handle owner, StringInterner::Handle account) {
+    OwnerShard& shard = ownerShardFor(owner);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+    std::vector<StringInterner::Handle>& accounts = shard.accounts[owner];
+    auto it = std::lower_bound(accounts.begin(), accounts.end(), account, accountNoLess);
+    if (it == accounts.end() || *it != account) {
+        accounts.insert(it, account);
+    }
+}
+
+// Remove an account from its owner's list
+void AccountRepository::unindexOwner(StringInterner::Handle owner, StringInterner::Handle account) {
+    OwnerShard& shard = ownerShardFor(owner);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+    auto entry = shard.accounts.find(owner);
+    if (entry == shard.accounts.end()) {
+        return;
+    }
+    std::vector<StringInterner::Handle>& accounts = entry->second;
+    auto it = std::lower_bound(accounts.begin(), accounts.end(), account, accountNoLess);
+    if (it != accounts.end() && *it == account) {
+        accounts.erase(it);
+    }
+    if (accounts.empty()) {
+        shard.accounts.erase(entry);
+    }
+}
+
+// Store an account pointer under its handle, growing the table if needed
+void AccountRepository::setHandleSlot(StringInterner::Handle account, Account* value) {
+    if (account >= byHandle.capacity()) {
+        std::lock_guard<std::mutex> lock(byHandleGrowMutex);
+        byHandle.reserve(static_cast<size_t>(account) + 1);
+    }
+    byHandle[account].store(value, std::memory_order_release);
+}
+
+// Find account under a shared shard lock
+Account* AccountRepository::find(const std::string& accountNo) const {
+    AccountIndex::Key key(accountNo);
+    const Shard& shard = shardFor(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.accounts.find(key);
+}
+
 // Get account by account number
 std::optional<Account*> AccountRepository::getByAccountNo(const std::string& accountNo) {
-    auto it = accounts.find(accountNo);
-    if (it != accounts.end()) {
-        return it->second;
+    Account* account = find(accountNo);
+    if (account != nullptr) {
+        return account;
     }
     return std::nullopt;  // Account not found
 }
 
+// Get account by handle
+Account* AccountRepository::getByHandle(StringInterner::Handle account) const {
+    if (account >= byHandle.capacity()) {
+        return nullptr;
+    }
+    return byHandle[account].load(std::memory_order_acquire);
+}
+
 // Save (add or update) an account
 bool AccountRepository::save(Account* account) {
     if (account == nullptr) {
-        std::cerr << "Cannot save null account" << std::endl;
+        LOG_WARN("Cannot save null account");
         return false;
     }
 
-    std::string accountNo = account->getAccountNo();
+    const std::string& accountNo = account->getAccountNo();
+    StringInterner::Handle accountHandle = account->getAccountHandle();
+    StringInterner::Handle ownerHandle = account->getOwnerHandle();
+    AccountIndex::Key key(accountNo);
+    Shard& shard = shardFor(key);
+    bool existed;
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        Account* previous = shard.accounts.insert(key, account);
+        existed = (previous != nullptr);
+
+        setHandleSlot(accountHandle, account);
+
+        if (!existed) {
+            indexOwner(ownerHandle, accountHandle);
+        } else {
+            StringInterner::Handle previousOwner = previous->getOwnerHandle();
+            if (previousOwner != ownerHandle) {
+                unindexOwner(previousOwner, accountHandle);
+                indexOwner(ownerHandle, accountHandle);
+            }
+        }
+    }
 
     // Check if account already exists
-    if (accounts.find(accountNo) != accounts.end()) {
+    if (existed) {
         // Update existing account
-        std::cout << "Updated existing account: " << accountNo << std::endl;
+        LOG_DEBUG("Updated existing account: ", accountNo);
     } else {
         // Add new account
-        std::cout << "Added new account: " << accountNo << std::endl;
+        accountCount.fetch_add(1, std::memory_order_relaxed);
+        LOG_DEBUG("Added new account: ", accountNo);
     }
 
-    accounts[accountNo] = account;
     return true;
 }
 
 // Remove account by account number
 bool AccountRepository::remove(const std::string& accountNo) {
-    auto it = accounts.find(accountNo);
-    if (it != accounts.end()) {
-        // Delete the account object
-        delete it->second;
-        // Remove from map
-        accounts.erase(it);
-        std::cout << "Removed account: " << accountNo << std::endl;
+    AccountIndex::Key key(accountNo);
+    Shard& shard = shardFor(key);
+    Account* removed = nullptr;
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        // Remove from index and owner index
+        removed = shard.accounts.erase(key);
+        if (removed != nullptr) {
+            byHandle[removed->getAccountHandle()].store(nullptr, std::memory_order_release);
+            unindexOwner(removed->getOwnerHandle(), removed->getAccountHandle());
+        }
+    }
+
+    if (removed != nullptr) {
+        accountCount.fetch_sub(1, std::memory_order_relaxed);
+        {
+            // Unlinked, not deleted: lookups made before the removal may
+            // still be using it (see reclaimRemoved)
+            std::lock_guard<std::mutex> lock(removedMutex);
+            removedAccountNos.push_back(accountNo);
+            retiredAccounts.push_back(removed);
+        }
+        LOG_DEBUG("Removed account: ", accountNo);
         return true;
     }
 
-    std::cerr << "Account not found: " << accountNo << std::endl;
+    LOG_DEBUG("Account not found: ", accountNo);
     return false;
 }
 
+// Delete removed accounts once nobody can reach them
+size_t AccountRepository::reclaimRemoved() {
+    std::vector<Account*> retired;
+    {
+        std::lock_guard<std::mutex> lock(removedMutex);
+        retired.swap(retiredAccounts);
+    }
+    for (Account* account : retired) {
+        delete account;
+    }
+    return retired.size();
+}
+
 // Find all account numbers owned by a specific owner
 std::vector<std::string> AccountRepository::findByOwnerId(const std::string& ownerId) {
     std::vector<std::string> result;
-
-    for (const auto& pair : accounts) {
-        if (pair.second->getOwnerId() == ownerId) {
-            result.push_back(pair.first);
-        }
+    StringInterner::Handle owner = StringInterner::ownerIds().find(ownerId);
+    if (owner == StringInterner::INVALID_HANDLE) {
+        return result;
     }
 
+    const StringInterner& accountNumbers = StringInterner::accountNumbers();
+    for (StringInterner::Handle account : findByOwner(owner)) {
+        result.push_back(accountNumbers.view(account));
+    }
     return result;
 }
 
+// Find the account handles of an owner
+std::vector<StringInterner::Handle> AccountRepository::findByOwner(StringInterner::Handle owner) {
+    OwnerShard& shard = ownerShardFor(owner);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+    auto it = shard.accounts.find(owner);
+    if (it != shard.accounts.end()) {
+        return it->second;  // Already sorted by account number
+    }
+    return std::vector<StringInterner::Handle>();
+}
+
 // Check if account number exists
 bool AccountRepository::existsAccountNo(const std::string& accountNo) const {
-    return accounts.find(accountNo) != accounts.end();
+    return find(accountNo) != nullptr;
 }
 
 // Get balance of specific account
-double AccountRepository::getBalance(const std::string& accountNo) const {
-    auto it = accounts.find(accountNo);
-    if (it != accounts.end()) {
-        return it->second->getBalance();
+Money AccountRepository::getBalance(const std::string& accountNo) const {
+    Account* account = find(accountNo);
+    if (account != nullptr) {
+        std::lock_guard<std::mutex> lock(account->getMutex());
+        return account->getBalance();
     }
 
-    std::cerr << "Account not found: " << accountNo << std::endl;
-    return 0.0;
+    LOG_DEBUG("Account not found: ", accountNo);
+    return Money();
 }
 
 // Get minimum balance (for savings accounts)
-double AccountRepository::getMinBalance(const std::string& accountNo) const {
-    auto it = accounts.find(accountNo);
-    if (it != accounts.end()) {
-        // For now, return 0.0 as we haven't implemented minimum balance tracking
+Money AccountRepository::getMinBalance(const std::string& accountNo) const {
+    if (find(accountNo) != nullptr) {
+        // For now, return 0.00 as we haven't implemented minimum balance tracking
         // This would be account-type specific
-        return 0.0;
+        return Money();
     }
 
-    std::cerr << "Account not found: " << accountNo << std::endl;
-    return 0.0;
+    LOG_DEBUG("Account not found: ", accountNo);
+    return Money();
 }
 
 // Get overdraft limit (for chequing accounts)
-double AccountRepository::getOverdraftLimit(const std::string& accountNo) const {
-    auto it = accounts.find(accountNo);
-    if (it != accounts.end()) {
+Money AccountRepository::getOverdraftLimit(const std::string& accountNo) const {
+    Account* account = find(accountNo);
+    if (account != nullptr) {
         // Try to cast to ChequingAccount
-        ChequingAccount* chequing = dynamic_cast<ChequingAccount*>(it->second);
+        ChequingAccount* chequing = dynamic_cast<ChequingAccount*>(account);
         if (chequing != nullptr) {
+            std::lock_guard<std::mutex> lock(account->getMutex());
             return chequing->getOverdraftLimit();
         }
         // Not a chequing account - no overdraft
-        return 0.0;
+        return Money();
     }
 
-    std::cerr << "Account not found: " << accountNo << std::endl;
-    return 0.0;
+    LOG_DEBUG("Account not found: ", accountNo);
+    return Money();
 }
 
 // Get all accounts
 std::vector<Account*> AccountRepository::getAllAccounts() const {
+    // Sort (account number, account) pairs so comparisons do not have to
+    // chase each account and its interned number
+    std::vector<std::pair<std::string_view, Account*>> entries;
+    entries.reserve(getAccountCount());
+
+    for (const Shard& shard : shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        shard.accounts.forEach([&entries](Account* account) {
+            entries.emplace_back(account->getAccountNo(), account);
+        });
+    }
+
+    // Shards are hash-ordered; keep reports in account number order
+    std::sort(entries.begin(), entries.end(),
+              [](const std::pair<std::string_view, Account*>& a,
+                 const std::pair<std::string_view, Account*>& b) {
+                  return a.first < b.first;
+              });
+
     std::vector<Account*> result;
-    for (const auto& pair : accounts) {
-        result.push_back(pair.second);
+    result.reserve(entries.size());
+    for (const auto& entry : entries) {
+        result.push_back(entry.second);
     }
     return result;
 }
 
 // Get count of accounts
 size_t AccountRepository::getAccountCount() const {
-    return accounts.size();
+    return accountCount.load(std::memory_order_relaxed);
+}
+
+// Accounts changed since the last checkpoint
+std::vector<Account*> AccountRepository::getDirtyAccounts() const {
+    std::vector<Account*> result;
+    for (const Shard& shard : shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        shard.accounts.forEach([&result](Account* account) {
+            if (account->isDirty()) {
+                result.push_back(account);
+            }
+        });
+    }
+    return result;
+}
+
+// Removed account numbers since the last checkpoint
+std::vector<std::string> AccountRepository::takeRemovedAccountNos() {
+    std::lock_guard<std::mutex> lock(removedMutex);
+    std::vector<std::string> result;
+    result.swap(removedAccountNos);
+    return result;
+}
+
+// Forget pending changes
+void AccountRepository::markClean() {
+    for (const Shard& shard : shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        shard.accounts.forEach([](Account* account) {
+            account->clearDirty();
+        });
+    }
+    std::lock_guard<std::mutex> lock(removedMutex);
+    removedAccountNos.clear();
 }
 
 // Clear all accounts
 void AccountRepository::clear() {
-    // Delete all account objects
-    for (auto& pair : accounts) {
-        delete pair.second;
+    for (Shard& shard : shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        // Delete all account objects
+        shard.accounts.forEach([this](Account* account) {
+            byHandle[account->getAccountHandle()].store(nullptr, std::memory_order_relaxed);
+            delete account;
+        });
+        // Clear the index
+        shard.accounts.clear();
     }
-    // Clear the map
-    accounts.clear();
-}
\ No newline at end of file
+    for (OwnerShard& shard : ownerShards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.accounts.clear();
+    }
+    accountCount.store(0, std::memory_order_relaxed);
+    reclaimRemoved();
+}
@@ -2,18 +2,88 @@
 
 #include <string>
 #include <vector>
-#include <map>
+#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <shared_mutex>
 #include <optional>
 #include "Account.h"
+#include "AccountIndex.h"
+#include "SegmentedArray.h"
+#include "StringInterner.h"
 
 /**
  * AccountRepository - Repository Pattern for account storage and retrieval
  * Manages the collection of accounts and provides query methods
+ *
+ * Accounts are held in flat open-addressing hash tables (AccountIndex).
+ *
+ * Thread-safe: accounts are hash-sharded by account number and each shard is
+ * guarded by its own reader/writer lock, so lookups on different accounts
+ * never contend. Balance changes are serialized by the per-account lock
+ * (see Account::getMutex), not by the shard lock.
+ *
+ * Accounts can also be fetched by their interned account handle (see
+ * StringInterner) from a flat array, without hashing or locking.
+ *
+ * A secondary index from owner handle to account handles (sharded the same
+ * way, by owner) is kept in step by save/remove, so findByOwnerId touches
+ * only that owner's entry instead of scanning every account.
+ *
+ * Removing an account only unlinks it: the Account object stays valid for
+ * threads that already hold its pointer and is deleted by reclaimRemoved,
+ * which callers run at a quiescent point (or by clear/the destructor).
  */
 class AccountRepository {
 private:
-    // Storage: map of accountNo -> Account*
-    std::map<std::string, Account*> accounts;
+    // Number of independently locked shards (must be a power of two)
+    static constexpr size_t SHARD_COUNT = 64;
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        // Storage: accountNo -> Account*
+        AccountIndex accounts;
+    };
+
+    struct OwnerShard {
+        mutable std::shared_mutex mutex;
+        // Secondary index: owner handle -> account handles sorted by account number
+        std::unordered_map<StringInterner::Handle, std::vector<StringInterner::Handle>> accounts;
+    };
+
+    std::array<Shard, SHARD_COUNT> shards;
+    std::array<OwnerShard, SHARD_COUNT> ownerShards;
+    std::atomic<size_t> accountCount;
+
+    // Account handle -> Account* (nullptr for removed or foreign handles)
+    SegmentedArray<std::atomic<Account*>> byHandle;
+    std::mutex byHandleGrowMutex;
+
+    // Account numbers removed since the last checkpoint
+    std::mutex removedMutex;
+    std::vector<std::string> removedAccountNos;
+
+    // Removed accounts not yet deleted (guarded by removedMutex): a thread
+    // that looked one up before the removal may still be using it
+    std::vector<Account*> retiredAccounts;
+
+    // Select the shard responsible for an account number (top hash bits;
+    // the index itself uses the low bits)
+    Shard& shardFor(const AccountIndex::Key& key);
+    const Shard& shardFor(const AccountIndex::Key& key) const;
+
+    // Select the owner index shard responsible for an owner
+    OwnerShard& ownerShardFor(StringInterner::Handle owner);
+
+    // Owner index maintenance (called with the account's shard lock held)
+    void indexOwner(StringInterner::Handle owner, StringInterner::Handle account);
+    void unindexOwner(StringInterner::Handle owner, StringInterner::Handle account);
+
+    // Publish an account in the handle table
+    void setHandleSlot(StringInterner::Handle account, Account* value);
+
+    // Find account without reporting errors (nullptr if not found)
+    Account* find(const std::string& accountNo) const;
 
 public:
     // Constructor
@@ -22,42 +92,65 @@ public:
     // Destructor - cleanup all accounts
     ~AccountRepository();
 
+    AccountRepository(const AccountRepository&) = delete;
+    AccountRepository& operator=(const AccountRepository&) = delete;
+
     // Get account by account number
     // Returns std::optional containing Account* if found, empty optional if not found
     std::optional<Account*> getByAccountNo(const std::string& accountNo);
 
+    // Get account by interned account handle (nullptr if not stored)
+    Account* getByHandle(StringInterner::Handle account) const;
+
     // Save (add or update) an account
     // Returns true if successful
     bool save(Account* account);
 
     // Remove account by account number
-    // Returns true if account was found and removed
+    // Returns true if account was found and removed; the object itself is
+    // kept until reclaimRemoved
     bool remove(const std::string& accountNo);
 
+    // Delete the objects of removed accounts; returns how many. Call only
+    // when no other thread can hold an Account* looked up before the removal
+    size_t reclaimRemoved();
+
     // Find all account numbers owned by a specific owner
     std::vector<std::string> findByOwnerId(const std::string& ownerId);
 
+    // Handles of the accounts of an owner, ordered by account number
+    std::vector<StringInterner::Handle> findByOwner(StringInterner::Handle owner);
+
     // Check if account number exists
     bool existsAccountNo(const std::string& accountNo) const;
 
     // Get balance of specific account
-    // Returns 0.0 if account not found
-    double getBalance(const std::string& accountNo) const;
+    // Returns 0.00 if account not found
+    Money getBalance(const std::string& accountNo) const;
 
     // Get minimum balance (for savings accounts, typically)
-    // Returns 0.0 if account not found or not applicable
-    double getMinBalance(const std::string& accountNo) const;
+    // Returns 0.00 if account not found or not applicable
+    Money getMinBalance(const std::string& accountNo) const;
 
     // Get overdraft limit (for chequing accounts)
-    // Returns 0.0 if account not found or not applicable
-    double getOverdraftLimit(const std::string& accountNo) const;
+    // Returns 0.00 if account not found or not applicable
+    Money getOverdraftLimit(const std::string& accountNo) const;
 
-    // Get all accounts (useful for reporting)
+    // Get all accounts (useful for reporting), ordered by account number
     std::vector<Account*> getAllAccounts() const;
 
     // Get count of accounts
     size_t getAccountCount() const;
 
+    // Accounts changed since the last checkpoint (unordered)
+    std::vector<Account*> getDirtyAccounts() const;
+
+    // Account numbers removed since the last checkpoint; empties the list
+    std::vector<std::string> takeRemovedAccountNos();
+
+    // Forget all pending changes (after a full save or load)
+    void markClean();
+
     // Clear all accounts
     void clear();
 };
@@ -1,5 +1,5 @@
 #include "AuthService.h"
-#include <iostream>
+#include "Logger.h"
 
 // Constructor
 AuthService::AuthService(UserRepository& users, PasswordHasher& hasher)
@@ -11,23 +11,23 @@ bool AuthService::registerUser(const std::string& userId, const std::string& nam
                                const std::string& email, const std::string& password) {
     // Validate inputs
     if (userId.empty()) {
-        std::cerr << "User ID cannot be empty" << std::endl;
+        LOG_DEBUG("User ID cannot be empty");
         return false;
     }
 
     if (name.empty()) {
-        std::cerr << "Name cannot be empty" << std::endl;
+        LOG_DEBUG("Name cannot be empty");
         return false;
     }
 
     if (password.length() < 4) {
-        std::cerr << "Password must be at least 4 characters" << std::endl;
+        LOG_DEBUG("Password must be at least 4 characters");
         return false;
     }
 
     // Check if user already exists
     if (users.existsUserId(userId)) {
-        std::cerr << "User ID already exists: " << userId << std::endl;
+        LOG_DEBUG("User ID already exists: ", userId);
         return false;
     }
 
@@ -39,7 +39,7 @@ bool AuthService::registerUser(const std::string& userId, const std::string& nam
 
     // Save to repository
     if (users.save(newUser)) {
-        std::cout << "User registered successfully: " << userId << std::endl;
+        LOG_DEBUG("User registered successfully: ", userId);
         return true;
     }
 
@@ -49,45 +49,76 @@ bool AuthService::registerUser(const std::string& userId, const std::string& nam
 // Login a user
 User* AuthService::login(const std::string& userId,
                          const std::string& password) {
-    // Check if user exists
-    if (!users.existsUserId(userId)) {
-        std::cerr << "User not found: " << userId << std::endl;
+    User* user = users.getByUserId(userId);
+    if (user == nullptr) {
+        LOG_DEBUG("User not found: ", userId);
         return nullptr;
     }
 
-    // Get user
-    User* user = users.getByUserId(userId);
-    if (user == nullptr) {
+    // Refuse before hashing if the user is locked out or the global
+    // verification budget is exhausted
+    if (!throttle.tryAcquire(userId)) {
+        LOG_WARN("Login attempt throttled for user: ", userId);
         return nullptr;
     }
 
     // Verify password
     if (!hasher.verify(password, user->getPasswordHash())) {
-        std::cerr << "Invalid password for user: " << userId << std::endl;
+        throttle.recordFailure(userId);
+        LOG_WARN("Invalid password for user: ", userId);
         return nullptr;
     }
+    throttle.recordSuccess(userId);
+
+    // Upgrade legacy or under-cost hashes while the password is at hand
+    if (hasher.needsRehash(user->getPasswordHash())) {
+        user->setPasswordHash(hasher.hash(password));
+    }
 
-    // Update last login time
+    // Update last login time (user points into the repository)
     user->updateLastLogin();
-    users.save(*user);
 
-    std::cout << "Login successful: " << userId << std::endl;
+    LOG_DEBUG("Login successful: ", userId);
     return user;
 }
 
+// Login and open a session
+std::string AuthService::startSession(const std::string& userId,
+                                      const std::string& password) {
+    if (login(userId, password) == nullptr) {
+        return std::string();
+    }
+    return sessions.create(userId);
+}
+
+// Resolve a session token
+User* AuthService::authenticate(const std::string& token) {
+    std::optional<std::string> userId = sessions.lookup(token);
+    if (!userId) {
+        return nullptr;
+    }
+    return users.getByUserId(*userId);
+}
+
+// Close a session
+void AuthService::endSession(const std::string& token) {
+    sessions.revoke(token);
+}
+
 // Change password
 bool AuthService::changePassword(const std::string& userId,
                                 const std::string& oldPassword,
-                                const std::string& newPassword) {
+                                const std::string& newPassword,
+                                std::string* newSessionToken) {
     // Verify old password first
     User* user = login(userId, oldPassword);
     if (user == nullptr) {
-        std::cerr << "Cannot change password: authentication failed" << std::endl;
+        LOG_DEBUG("Cannot change password: authentication failed");
         return false;
     }
 
     if (newPassword.length() < 4) {
-        std::cerr << "New password must be at least 4 characters" << std::endl;
+        LOG_DEBUG("New password must be at least 4 characters");
         return false;
     }
 
@@ -96,9 +127,14 @@ bool AuthService::changePassword(const std::string& userId,
 
     // Update user
     user->setPasswordHash(newPasswordHash);
-    users.save(*user);
 
-    std::cout << "Password changed successfully for user: " << userId << std::endl;
+    // Sessions opened with the old password must not outlive it
+    sessions.revokeUser(userId);
+    if (newSessionToken != nullptr) {
+        *newSessionToken = sessions.create(userId);
+    }
+
+    LOG_DEBUG("Password changed successfully for user: ", userId);
     return true;
 }
 
@@ -110,4 +146,12 @@ bool AuthService::userExists(const std::string& userId) const {
 // Get user count
 size_t AuthService::getUserCount() const {
     return users.getUserCount();
+}
+
+SessionStore& AuthService::getSessionStore() {
+    return sessions;
+}
+
+LoginThrottle& AuthService::getLoginThrottle() {
+    return throttle;
 }
\ No newline at end of file
@@ -5,15 +5,24 @@
 #include "User.h"
 #include "UserRepository.h"
 #include "PasswordHasher.h"
+#include "SessionStore.h"
+#include "LoginThrottle.h"
 
 /**
  * AuthService - Handles user authentication
  * Provides login and registration functionality
+ *
+ * A successful login can open a session: the caller keeps the returned
+ * token and authenticates later requests with a table lookup instead of
+ * re-verifying the password. Password checks are rate limited per user
+ * and globally (see LoginThrottle).
  */
 class AuthService {
 private:
     UserRepository& users;
     PasswordHasher& hasher;
+    SessionStore sessions;
+    LoginThrottle throttle;
 
 public:
     // Constructor
@@ -26,15 +35,28 @@ public:
     // Login a user (returns nullptr if login fails)
     User* login(const std::string& userId, const std::string& password);
 
-    // Change password
+    // Login and open a session; returns the token (empty if login fails)
+    std::string startSession(const std::string& userId, const std::string& password);
+
+    // User owning a live session (nullptr if the token is unknown or expired)
+    User* authenticate(const std::string& token);
+
+    // Close a session
+    void endSession(const std::string& token);
+
+    // Change password. Every session of the user is revoked; if
+    // newSessionToken is given, it receives a fresh session for the caller
     bool changePassword(const std::string& userId, const std::string& oldPassword,
-                       const std::string& newPassword);
+                       const std::string& newPassword, std::string* newSessionToken = nullptr);
 
     // Check if user exists
     bool userExists(const std::string& userId) const;
 
     // Get user count
     size_t getUserCount() const;
+
+    SessionStore& getSessionStore();
+    LoginThrottle& getLoginThrottle();
 };
 
 #endif // AUTHSERVICE_H
\ No newline at end of file
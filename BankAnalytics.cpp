@@ -0,0 +1,269 @@
+#include "BankAnalytics.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define BANK_ANALYTICS_AVX2 1
+#endif
+
+namespace {
+
+constexpr std::uint8_t CHEQUING = static_cast<std::uint8_t>(AccountType::Chequing);
+
+// Running totals in cents, merged into a BookSummary at the end
+struct SummaryTotals {
+    std::int64_t count[BookSummary::TYPE_COUNT] = {};
+    std::int64_t balance[BookSummary::TYPE_COUNT] = {};
+    std::int64_t drawn = 0;
+    std::int64_t available = 0;
+    std::int64_t overdrawn = 0;
+};
+
+std::atomic<bool> simdEnabled{true};
+
+// ===== Scalar kernels =====
+
+void summarizeScalar(const LedgerColumns& columns, size_t begin, size_t end,
+                     SummaryTotals& totals) {
+    for (size_t i = begin; i < end; ++i) {
+        std::uint8_t type = columns.type[i];
+        std::int64_t balance = columns.balance[i];
+
+        for (size_t k = 0; k < BookSummary::TYPE_COUNT; ++k) {
+            bool match = type == k;
+            totals.count[k] += match ? 1 : 0;
+            totals.balance[k] += match ? balance : 0;
+        }
+
+        bool chequing = type == CHEQUING;
+        std::int64_t negative = balance < 0 ? balance : 0;
+        std::int64_t headroom = columns.overdraft[i] + negative;
+        totals.drawn -= chequing ? negative : 0;
+        totals.overdrawn += (chequing && balance < 0) ? 1 : 0;
+        totals.available += (chequing && headroom > 0) ? headroom : 0;
+    }
+}
+
+// atLeast[j] += open rows with balance >= edges[j]; returns open rows seen
+std::int64_t histogramScalar(const LedgerColumns& columns, size_t begin, size_t end,
+                             const std::int64_t* edges, size_t edgeCount,
+                             std::int64_t* atLeast) {
+    std::int64_t open = 0;
+    for (size_t i = begin; i < end; ++i) {
+        bool isOpen = columns.type[i] != LedgerColumns::EMPTY_TYPE;
+        std::int64_t balance = columns.balance[i];
+        open += isOpen ? 1 : 0;
+        for (size_t j = 0; j < edgeCount; ++j) {
+            atLeast[j] += (isOpen && balance >= edges[j]) ? 1 : 0;
+        }
+    }
+    return open;
+}
+
+// ===== AVX2 kernels =====
+
+#ifdef BANK_ANALYTICS_AVX2
+
+__attribute__((target("avx2")))
+std::int64_t horizontalSum(__m256i value) {
+    alignas(32) std::int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), value);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+// Four type bytes widened to four 64-bit lanes
+__attribute__((target("avx2")))
+__m256i loadTypes(const std::uint8_t* types) {
+    std::int32_t packed;
+    std::memcpy(&packed, types, sizeof(packed));
+    return _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(packed));
+}
+
+__attribute__((target("avx2")))
+void summarizeAvx2(const LedgerColumns& columns, SummaryTotals& totals) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i typeIds[BookSummary::TYPE_COUNT];
+    __m256i counts[BookSummary::TYPE_COUNT];
+    __m256i sums[BookSummary::TYPE_COUNT];
+    for (size_t k = 0; k < BookSummary::TYPE_COUNT; ++k) {
+        typeIds[k] = _mm256_set1_epi64x(static_cast<long long>(k));
+        counts[k] = zero;
+        sums[k] = zero;
+    }
+    __m256i drawn = zero;
+    __m256i available = zero;
+    __m256i overdrawn = zero;
+
+    size_t i = 0;
+    for (; i + 4 <= columns.rows; i += 4) {
+        __m256i type = loadTypes(columns.type + i);
+        __m256i balance = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns.balance + i));
+        __m256i overdraft = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns.overdraft + i));
+
+        // Match masks are all ones, so subtracting one counts the lane
+        for (size_t k = 0; k < BookSummary::TYPE_COUNT; ++k) {
+            __m256i match = _mm256_cmpeq_epi64(type, typeIds[k]);
+            counts[k] = _mm256_sub_epi64(counts[k], match);
+            sums[k] = _mm256_add_epi64(sums[k], _mm256_and_si256(match, balance));
+        }
+
+        __m256i chequing = _mm256_cmpeq_epi64(type, typeIds[CHEQUING]);
+        __m256i negativeMask = _mm256_and_si256(chequing, _mm256_cmpgt_epi64(zero, balance));
+        __m256i negative = _mm256_and_si256(negativeMask, balance);
+        __m256i headroom = _mm256_add_epi64(overdraft, negative);
+        __m256i headroomMask = _mm256_and_si256(chequing, _mm256_cmpgt_epi64(headroom, zero));
+
+        drawn = _mm256_sub_epi64(drawn, negative);
+        overdrawn = _mm256_sub_epi64(overdrawn, negativeMask);
+        available = _mm256_add_epi64(available, _mm256_and_si256(headroomMask, headroom));
+    }
+
+    for (size_t k = 0; k < BookSummary::TYPE_COUNT; ++k) {
+        totals.count[k] += horizontalSum(counts[k]);
+        totals.balance[k] += horizontalSum(sums[k]);
+    }
+    totals.drawn += horizontalSum(drawn);
+    totals.available += horizontalSum(available);
+    totals.overdrawn += horizontalSum(overdrawn);
+
+    summarizeScalar(columns, i, columns.rows, totals);
+}
+
+__attribute__((target("avx2")))
+std::int64_t histogramAvx2(const LedgerColumns& columns, const std::int64_t* edges,
+                           size_t edgeCount, std::int64_t* atLeast) {
+    constexpr size_t EDGE_BLOCK = 8;
+    const __m256i emptyType = _mm256_set1_epi64x(LedgerColumns::EMPTY_TYPE);
+    const __m256i one = _mm256_set1_epi64x(1);
+    const size_t vectorRows = columns.rows & ~size_t(3);
+    __m256i openCount = _mm256_setzero_si256();
+
+    // Up to EDGE_BLOCK edge counters stay in registers per pass over the
+    // rows; open rows are counted during the first pass
+    size_t first = 0;
+    do {
+        size_t blockSize = std::min(EDGE_BLOCK, edgeCount - first);
+        __m256i edge[EDGE_BLOCK];
+        __m256i count[EDGE_BLOCK];
+        for (size_t j = 0; j < blockSize; ++j) {
+            edge[j] = _mm256_set1_epi64x(edges[first + j]);
+            count[j] = _mm256_setzero_si256();
+        }
+
+        for (size_t i = 0; i < vectorRows; i += 4) {
+            __m256i type = loadTypes(columns.type + i);
+            __m256i balance = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns.balance + i));
+            __m256i closed = _mm256_cmpeq_epi64(type, emptyType);
+            if (first == 0) {
+                openCount = _mm256_add_epi64(openCount, _mm256_andnot_si256(closed, one));
+            }
+
+            // balance >= edge  <=>  !(edge > balance)
+            for (size_t j = 0; j < blockSize; ++j) {
+                __m256i below = _mm256_or_si256(closed, _mm256_cmpgt_epi64(edge[j], balance));
+                count[j] = _mm256_add_epi64(count[j], _mm256_andnot_si256(below, one));
+            }
+        }
+
+        for (size_t j = 0; j < blockSize; ++j) {
+            atLeast[first + j] += horizontalSum(count[j]);
+        }
+        first += EDGE_BLOCK;
+    } while (first < edgeCount);
+
+    return horizontalSum(openCount) +
+           histogramScalar(columns, vectorRows, columns.rows, edges, edgeCount, atLeast);
+}
+
+bool cpuHasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+#endif  // BANK_ANALYTICS_AVX2
+
+bool useAvx2() {
+#ifdef BANK_ANALYTICS_AVX2
+    return simdEnabled.load(std::memory_order_relaxed) && cpuHasAvx2();
+#else
+    return false;
+#endif
+}
+
+}  // namespace
+
+// Per-type totals and overdraft figures
+BookSummary BankAnalytics::summarize(const Ledger& ledger) {
+    SummaryTotals totals;
+    const bool avx2 = useAvx2();
+
+    ledger.scanChunks([&](const LedgerColumns& columns) {
+#ifdef BANK_ANALYTICS_AVX2
+        if (avx2) {
+            summarizeAvx2(columns, totals);
+            return;
+        }
+#endif
+        (void)avx2;
+        summarizeScalar(columns, 0, columns.rows, totals);
+    });
+
+    BookSummary summary;
+    for (size_t k = 0; k < BookSummary::TYPE_COUNT; ++k) {
+        summary.accountsByType[k] = static_cast<size_t>(totals.count[k]);
+        summary.balanceByType[k] = Money::fromCents(totals.balance[k]);
+    }
+    summary.overdraftDrawn = Money::fromCents(totals.drawn);
+    summary.overdraftAvailable = Money::fromCents(totals.available);
+    summary.overdrawnAccounts = static_cast<size_t>(totals.overdrawn);
+    return summary;
+}
+
+// Balance-bucket histogram
+std::vector<size_t> BankAnalytics::balanceHistogram(const Ledger& ledger,
+                                                    const std::vector<Money>& edges) {
+    std::vector<std::int64_t> edgeCents;
+    edgeCents.reserve(edges.size());
+    for (size_t j = 0; j < edges.size(); ++j) {
+        if (j > 0 && !(edges[j - 1] < edges[j])) {
+            throw std::invalid_argument("Histogram edges must be strictly ascending");
+        }
+        edgeCents.push_back(edges[j].getCents());
+    }
+
+    std::vector<std::int64_t> atLeast(edgeCents.size(), 0);
+    std::int64_t open = 0;
+    const bool avx2 = useAvx2();
+
+    ledger.scanChunks([&](const LedgerColumns& columns) {
+#ifdef BANK_ANALYTICS_AVX2
+        if (avx2) {
+            open += histogramAvx2(columns, edgeCents.data(), edgeCents.size(), atLeast.data());
+            return;
+        }
+#endif
+        (void)avx2;
+        open += histogramScalar(columns, 0, columns.rows, edgeCents.data(), edgeCents.size(),
+                                atLeast.data());
+    });
+
+    // Counts at or above each edge -> counts between consecutive edges
+    std::vector<size_t> buckets(edgeCents.size() + 1);
+    std::int64_t previous = open;
+    for (size_t j = 0; j < atLeast.size(); ++j) {
+        buckets[j] = static_cast<size_t>(previous - atLeast[j]);
+        previous = atLeast[j];
+    }
+    buckets.back() = static_cast<size_t>(previous);
+    return buckets;
+}
+
+const char* BankAnalytics::kernelName() {
+    return useAvx2() ? "avx2" : "scalar";
+}
+
+void BankAnalytics::setSimdEnabled(bool enabled) {
+    simdEnabled.store(enabled, std::memory_order_relaxed);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "AccountType.h"
+#include "Ledger.h"
+#include "Money.h"
+
+/**
+ * BookSummary - Book-level figures computed by BankAnalytics::summarize
+ */
+struct BookSummary {
+    static constexpr size_t TYPE_COUNT = 3;  // Savings, Chequing, TFSA
+
+    std::array<size_t, TYPE_COUNT> accountsByType{};
+    std::array<Money, TYPE_COUNT> balanceByType{};
+
+    Money overdraftDrawn;       // Sum of negative chequing balances, as a positive amount
+    Money overdraftAvailable;   // Unused chequing overdraft headroom
+    size_t overdrawnAccounts = 0;
+
+    // Worst case the bank can be owed by chequing customers
+    Money overdraftExposure() const { return overdraftDrawn + overdraftAvailable; }
+
+    Money balanceFor(AccountType type) const {
+        return balanceByType[static_cast<size_t>(type)];
+    }
+    size_t accountsFor(AccountType type) const {
+        return accountsByType[static_cast<size_t>(type)];
+    }
+};
+
+/**
+ * BankAnalytics - Vectorized book-wide aggregates over a Ledger
+ *
+ * Works directly on the ledger's column arrays, so a full pass reads
+ * contiguous memory and never touches Account objects. Kernels use AVX2
+ * (four balances per instruction) when the CPU supports it, chosen at run
+ * time, with a portable scalar fallback producing identical results.
+ */
+class BankAnalytics {
+public:
+    // Totals per account type plus overdraft drawn/available
+    static BookSummary summarize(const Ledger& ledger);
+
+    // Number of open accounts per balance bucket. With ascending edges
+    // e0 < e1 < ... < ek, bucket 0 counts balances below e0, bucket i counts
+    // [e(i-1), e(i)) and bucket k+1 counts balances at or above ek.
+    static std::vector<size_t> balanceHistogram(const Ledger& ledger,
+                                                const std::vector<Money>& edges);
+
+    // Name of the kernel set in use ("avx2" or "scalar")
+    static const char* kernelName();
+
+    // Force the scalar kernels (for testing and comparison)
+    static void setSimdEnabled(bool enabled);
+};
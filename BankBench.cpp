@@ -0,0 +1,748 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AccountFactory.h"
+#include "AccountRepository.h"
+#include "BankAnalytics.h"
+#include "BankSystem.h"
+#include "ChequingAccount.h"
+#include "DataPersistence.h"
+#include "InterestEngine.h"
+#include "Ledger.h"
+#include "OutputBuffer.h"
+#include "PasswordHasher.h"
+#include "SavingsAccount.h"
+#include "StatementGenerator.h"
+#include "Timestamp.h"
+#include "TransferTransaction.h"
+
+/**
+ * bank_bench - Microbenchmarks for the banking core
+ *
+ * Modelled on Google Benchmark: each benchmark runs a timed loop whose
+ * iteration count is grown until the loop takes at least --min-time
+ * seconds, and reports time per iteration. All inputs come from seeded
+ * generators, so runs are reproducible and their JSON output
+ * (--format=json, same layout as Google Benchmark) can be diffed across
+ * releases.
+ *
+ * Usage: bank_bench [--filter=substring] [--min-time=seconds]
+ *                   [--format=console|json|csv] [--out=file]
+ */
+
+namespace {
+
+// Keep the compiler from discarding a benchmarked result
+template <typename T>
+void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// ===== Timing state =====
+
+class State {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::uint64_t iterations;
+    std::uint64_t remaining;
+    bool started;
+    Clock::time_point startTime;
+    Clock::duration elapsed;
+    std::uint64_t itemsProcessed;
+
+public:
+    explicit State(std::uint64_t iterations)
+        : iterations(iterations), remaining(iterations), started(false),
+          elapsed(Clock::duration::zero()), itemsProcessed(0) {}
+
+    // Loop condition: `while (state.keepRunning()) { ... }`
+    // Setup before the first call is not timed
+    bool keepRunning() {
+        if (!started) {
+            started = true;
+            startTime = Clock::now();
+        }
+        if (remaining == 0) {
+            elapsed += Clock::now() - startTime;
+            return false;
+        }
+        --remaining;
+        return true;
+    }
+
+    // Exclude work inside the loop from the measurement
+    void pauseTiming() { elapsed += Clock::now() - startTime; }
+    void resumeTiming() { startTime = Clock::now(); }
+
+    std::uint64_t getIterations() const { return iterations; }
+    double getSeconds() const { return std::chrono::duration<double>(elapsed).count(); }
+
+    void setItemsProcessed(std::uint64_t items) { itemsProcessed = items; }
+    std::uint64_t getItemsProcessed() const { return itemsProcessed; }
+};
+
+struct Benchmark {
+    std::string name;
+    std::function<void(State&)> function;
+    std::uint64_t fixedIterations;  // 0 = calibrate against --min-time
+};
+
+struct Result {
+    std::string name;
+    std::uint64_t iterations;
+    double nanosPerIteration;
+    double itemsPerSecond;
+};
+
+// ===== Synthetic data =====
+
+const std::uint64_t SEED = 20240601;
+
+std::string accountNoFor(size_t index) {
+    char buffer[24];
+    std::snprintf(buffer, sizeof(buffer), "ACC%09zu", index);
+    return buffer;
+}
+
+std::string ownerIdFor(size_t index) {
+    char buffer[24];
+    std::snprintf(buffer, sizeof(buffer), "user%07zu", index);
+    return buffer;
+}
+
+// Roughly three accounts per owner, two thirds savings, balances up to $100k
+void populate(AccountRepository& repository, size_t accountCount, Money minimumBalance = Money()) {
+    std::mt19937_64 rng(SEED);
+    size_t ownerCount = std::max<size_t>(1, accountCount / 3);
+    std::uniform_int_distribution<size_t> ownerDist(0, ownerCount - 1);
+    std::uniform_int_distribution<std::int64_t> centsDist(0, 10000000);
+    std::uniform_int_distribution<int> typeDist(0, 2);
+
+    for (size_t i = 0; i < accountCount; ++i) {
+        std::string ownerId = ownerIdFor(ownerDist(rng));
+        Money balance = minimumBalance + Money::fromCents(centsDist(rng));
+        Account* account;
+        if (typeDist(rng) != 0) {
+            account = new SavingsAccount(accountNoFor(i), ownerId, balance, 0.02);
+        } else {
+            account = new ChequingAccount(accountNoFor(i), ownerId, balance, Money::fromUnits(500));
+        }
+        repository.save(account);
+    }
+}
+
+// Account numbers visited in a fixed pseudo-random order
+std::vector<std::string> accessPattern(size_t accountCount, size_t length) {
+    std::mt19937_64 rng(SEED + 1);
+    std::uniform_int_distribution<size_t> dist(0, accountCount - 1);
+    std::vector<std::string> pattern(length);
+    for (std::string& accountNo : pattern) {
+        accountNo = accountNoFor(dist(rng));
+    }
+    return pattern;
+}
+
+// ===== Benchmarks =====
+
+const size_t POSTING_ACCOUNTS = 10000;
+const size_t PATTERN_LENGTH = 4096;
+
+void benchDeposit(State& state) {
+    AccountRepository repository;
+    AccountFactory factory;
+    BankSystem bank(repository, factory);
+    populate(repository, POSTING_ACCOUNTS);
+    std::vector<std::string> pattern = accessPattern(POSTING_ACCOUNTS, PATTERN_LENGTH);
+
+    size_t i = 0;
+    while (state.keepRunning()) {
+        doNotOptimize(bank.deposit(pattern[i++ & (PATTERN_LENGTH - 1)], Money::fromCents(1)));
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+// Deposits with a ledger attached: the cost of keeping it current
+void benchDepositWithLedger(State& state) {
+    AccountRepository repository;
+    AccountFactory factory;
+    BankSystem bank(repository, factory);
+    populate(repository, POSTING_ACCOUNTS);
+    Ledger ledger;
+    bank.setLedger(&ledger);
+    std::vector<std::string> pattern = accessPattern(POSTING_ACCOUNTS, PATTERN_LENGTH);
+
+    size_t i = 0;
+    while (state.keepRunning()) {
+        doNotOptimize(bank.deposit(pattern[i++ & (PATTERN_LENGTH - 1)], Money::fromCents(1)));
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void benchWithdraw(State& state) {
+    AccountRepository repository;
+    AccountFactory factory;
+    BankSystem bank(repository, factory);
+    populate(repository, POSTING_ACCOUNTS, Money::fromUnits(1000000000));
+    std::vector<std::string> pattern = accessPattern(POSTING_ACCOUNTS, PATTERN_LENGTH);
+
+    size_t i = 0;
+    while (state.keepRunning()) {
+        doNotOptimize(bank.withdraw(pattern[i++ & (PATTERN_LENGTH - 1)], Money::fromCents(1)));
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void benchTransfer(State& state) {
+    AccountRepository repository;
+    AccountFactory factory;
+    BankSystem bank(repository, factory);
+    populate(repository, POSTING_ACCOUNTS, Money::fromUnits(1000000000));
+    std::vector<std::string> pattern = accessPattern(POSTING_ACCOUNTS, PATTERN_LENGTH);
+
+    size_t i = 0;
+    while (state.keepRunning()) {
+        const std::string& from = pattern[i & (PATTERN_LENGTH - 1)];
+        const std::string& to = pattern[(i + 1) & (PATTERN_LENGTH - 1)];
+        ++i;
+        doNotOptimize(bank.transfer(from, to, Money::fromCents(1)));
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void benchGetByAccountNo(State& state, size_t accountCount) {
+    AccountRepository repository;
+    populate(repository, accountCount);
+    std::vector<std::string> pattern = accessPattern(accountCount, PATTERN_LENGTH);
+
+    size_t i = 0;
+    while (state.keepRunning()) {
+        doNotOptimize(repository.getByAccountNo(pattern[i++ & (PATTERN_LENGTH - 1)]));
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void benchFindByOwnerId(State& state, size_t accountCount) {
+    AccountRepository repository;
+    populate(repository, accountCount);
+
+    std::mt19937_64 rng(SEED + 2);
+    std::uniform_int_distribution<size_t> dist(0, std::max<size_t>(1, accountCount / 3) - 1);
+    std::vector<std::string> owners(PATTERN_LENGTH);
+    for (std::string& ownerId : owners) {
+        ownerId = ownerIdFor(dist(rng));
+    }
+
+    size_t i = 0;
+    while (state.keepRunning()) {
+        doNotOptimize(repository.findByOwnerId(owners[i++ & (PATTERN_LENGTH - 1)]));
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+std::string scratchPath(const char* name) {
+    return std::string("bank_bench_") + name + ".dat";
+}
+
+void benchSaveAccounts(State& state, size_t accountCount) {
+    AccountRepository repository;
+    populate(repository, accountCount);
+    DataPersistence persistence(scratchPath("accounts"), scratchPath("users"));
+
+    while (state.keepRunning()) {
+        doNotOptimize(persistence.saveAccounts(repository));
+    }
+    state.setItemsProcessed(state.getIterations() * accountCount);
+    std::remove(scratchPath("accounts").c_str());
+}
+
+void benchLoadAccounts(State& state, size_t accountCount) {
+    DataPersistence persistence(scratchPath("accounts"), scratchPath("users"));
+    {
+        AccountRepository repository;
+        populate(repository, accountCount);
+        persistence.saveAccounts(repository);
+    }
+
+    AccountFactory factory;
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        auto repository = std::make_unique<AccountRepository>();
+        state.resumeTiming();
+
+        doNotOptimize(persistence.loadAccounts(*repository, factory));
+
+        state.pauseTiming();
+        repository.reset();
+        state.resumeTiming();
+    }
+    state.setItemsProcessed(state.getIterations() * accountCount);
+    std::remove(scratchPath("accounts").c_str());
+}
+
+// Checkpoint after 1% of the book changed; includes periodic compaction
+void benchCheckpointAccounts(State& state, size_t accountCount) {
+    AccountRepository repository;
+    populate(repository, accountCount);
+    DataPersistence persistence(scratchPath("accounts"), scratchPath("users"));
+    persistence.saveAccounts(repository);
+
+    std::vector<Account*> accounts = repository.getAllAccounts();
+    size_t changed = std::max<size_t>(1, accountCount / 100);
+    size_t next = 0;
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        for (size_t i = 0; i < changed; ++i) {
+            Account* account = accounts[next++ % accounts.size()];
+            std::lock_guard<std::mutex> lock(account->getMutex());
+            account->deposit(Money::fromCents(1));
+        }
+        state.resumeTiming();
+
+        doNotOptimize(persistence.checkpointAccounts(repository));
+    }
+    state.setItemsProcessed(state.getIterations() * changed);
+    persistence.clearAccountsFile();
+}
+
+// Deposits into one account while another thread checkpoints in a loop, so
+// history spills race with saves that staged the same entries
+void benchDepositDuringCheckpoint(State& state) {
+    AccountRepository repository;
+    AccountFactory factory;
+    BankSystem bank(repository, factory);
+    DataPersistence persistence(scratchPath("accounts"), scratchPath("users"));
+    bank.setHistoryArchive(&persistence.getHistoryArchive());
+    std::string accountNo = bank.createAccount("bench", AccountType::Chequing)->getAccountNo();
+
+    std::atomic<bool> stop{false};
+    std::thread checkpointer([&] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            persistence.checkpointAccounts(repository);
+        }
+    });
+
+    while (state.keepRunning()) {
+        doNotOptimize(bank.deposit(accountNo, Money::fromCents(1)));
+    }
+    stop = true;
+    checkpointer.join();
+    state.setItemsProcessed(state.getIterations());
+
+    // Every deposit must survive the race exactly once, in memory and on disk
+    persistence.checkpointAccounts(repository);
+    size_t inMemory = bank.getTransactionHistory(accountNo).size();
+    size_t reloaded = 0;
+    {
+        AccountRepository loadedRepository;
+        AccountFactory loadedFactory;
+        BankSystem loadedBank(loadedRepository, loadedFactory);
+        DataPersistence loaded(scratchPath("accounts"), scratchPath("users"));
+        if (loaded.loadAccounts(loadedRepository, loadedFactory)) {
+            loadedBank.setHistoryArchive(&loaded.getHistoryArchive());
+            reloaded = loadedBank.getTransactionHistory(accountNo).size();
+        }
+    }
+    if (inMemory != state.getIterations() || reloaded != state.getIterations()) {
+        std::cerr << "History lost or duplicated: " << state.getIterations() << " deposits, "
+                  << inMemory << " in memory, " << reloaded << " after reload" << std::endl;
+        std::abort();
+    }
+    persistence.clearAccountsFile();
+}
+
+// Statement-style query: 1% of a long history, selected by time
+void benchHistoryRange(State& state, size_t entryCount) {
+    AccountRepository repository;
+    AccountFactory factory;
+    BankSystem bank(repository, factory);
+    DataPersistence persistence(scratchPath("accounts"), scratchPath("users"));
+    bank.setHistoryArchive(&persistence.getHistoryArchive());
+
+    Account* account = bank.createAccount("bench", AccountType::Chequing);
+    std::vector<std::int64_t> times;
+    times.reserve(entryCount);
+    for (size_t i = 0; i < entryCount; ++i) {
+        bank.deposit(account->getAccountNo(), Money::fromCents(1));
+        times.push_back(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+    persistence.checkpointAccounts(repository);
+
+    auto at = [](std::int64_t micros) {
+        return Timestamp(std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::microseconds(micros))));
+    };
+    std::mt19937_64 rng(42);
+    size_t window = std::max<size_t>(1, entryCount / 100);
+    size_t found = 0;
+    while (state.keepRunning()) {
+        size_t first = rng() % (entryCount - window);
+        std::vector<HistoryEntry> entries = bank.historyRange(
+            account->getAccountNo(), at(times[first]), at(times[first + window]));
+        found += entries.size();
+        doNotOptimize(entries.data());
+    }
+    state.setItemsProcessed(found);
+    persistence.clearAccountsFile();
+}
+
+// Month-end statements for the whole book into one stream
+void benchStatementsCombined(State& state, size_t accountCount) {
+    AccountRepository repository;
+    AccountFactory factory;
+    BankSystem bank(repository, factory);
+    DataPersistence persistence(scratchPath("accounts"), scratchPath("users"));
+    bank.setHistoryArchive(&persistence.getHistoryArchive());
+
+    populate(repository, accountCount);
+    std::vector<std::string> pattern = accessPattern(accountCount, accountCount * 20);
+    for (const std::string& accountNo : pattern) {
+        bank.deposit(accountNo, Money::fromCents(1));
+    }
+    persistence.checkpointAccounts(repository);
+
+    StatementGenerator generator(bank, ThreadPool::shared());
+    Timestamp from(2000, 1, 1);
+    Timestamp to(2100, 1, 1);
+    size_t postings = 0;
+    while (state.keepRunning()) {
+        postings += generator.writeCombined(from, to, scratchPath("statements")).postings;
+    }
+    state.setItemsProcessed(postings);
+    std::remove(scratchPath("statements").c_str());
+    persistence.clearAccountsFile();
+}
+
+// Month-end accrual over the whole book; each iteration is one day later
+void benchInterestEngineApplyAll(State& state, size_t accountCount) {
+    AccountRepository repository;
+    populate(repository, accountCount);
+    InterestEngine engine(repository, ThreadPool::shared());
+
+    auto now = std::chrono::system_clock::now();
+    while (state.keepRunning()) {
+        now += std::chrono::hours(24);
+        doNotOptimize(engine.applyAll(Timestamp(now)));
+    }
+    state.setItemsProcessed(state.getIterations() * accountCount);
+}
+
+void benchLedgerTotals(State& state, size_t accountCount) {
+    AccountRepository repository;
+    populate(repository, accountCount);
+    Ledger ledger;
+    ledger.loadFrom(repository);
+
+    while (state.keepRunning()) {
+        doNotOptimize(ledger.totals());
+    }
+    state.setItemsProcessed(state.getIterations() * accountCount);
+}
+
+void benchAnalyticsSummarize(State& state, size_t accountCount) {
+    AccountRepository repository;
+    AccountFactory factory;
+    BankSystem bank(repository, factory);
+    populate(repository, accountCount);
+    Ledger ledger;
+    bank.setLedger(&ledger);
+
+    while (state.keepRunning()) {
+        doNotOptimize(bank.summarizeBook());
+    }
+    state.setItemsProcessed(state.getIterations() * accountCount);
+}
+
+void benchAnalyticsHistogram(State& state, size_t accountCount) {
+    AccountRepository repository;
+    populate(repository, accountCount);
+    Ledger ledger;
+    ledger.loadFrom(repository);
+
+    // $0, $100, $1k, $10k, $25k, $50k, $75k, $100k
+    std::vector<Money> edges;
+    for (std::int64_t units : {0, 100, 1000, 10000, 25000, 50000, 75000, 100000}) {
+        edges.push_back(Money::fromUnits(units));
+    }
+
+    while (state.keepRunning()) {
+        doNotOptimize(BankAnalytics::balanceHistogram(ledger, edges));
+    }
+    state.setItemsProcessed(state.getIterations() * accountCount);
+}
+
+void benchPasswordHash(State& state) {
+    while (state.keepRunning()) {
+        doNotOptimize(PasswordHasher::hash("correct horse battery staple"));
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void benchPasswordVerify(State& state) {
+    std::string stored = PasswordHasher::hash("correct horse battery staple");
+    while (state.keepRunning()) {
+        doNotOptimize(PasswordHasher::verify("correct horse battery staple", stored));
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+// Audit-log rendering: the same transfer record, as a string and into a buffer
+void benchTransactionRecord(State& state) {
+    SavingsAccount from(accountNoFor(0), "bench", Money::fromUnits(1000), 0.01);
+    SavingsAccount to(accountNoFor(1), "bench", Money(), 0.01);
+    TransferTransaction transaction(from, to, Money::fromCents(12345), Timestamp::now(),
+                                    "Transfer via Bank System");
+
+    while (state.keepRunning()) {
+        doNotOptimize(transaction.record());
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+void benchTransactionFormatTo(State& state) {
+    SavingsAccount from(accountNoFor(0), "bench", Money::fromUnits(1000), 0.01);
+    SavingsAccount to(accountNoFor(1), "bench", Money(), 0.01);
+    TransferTransaction transaction(from, to, Money::fromCents(12345), Timestamp::now(),
+                                    "Transfer via Bank System");
+    OutputBuffer out;
+
+    while (state.keepRunning()) {
+        transaction.formatTo(out);
+        out.put('\n');
+        if (out.size() > OutputBuffer::DEFAULT_CAPACITY / 2) {
+            out.clear();
+        }
+    }
+    doNotOptimize(out.size());
+    state.setItemsProcessed(state.getIterations());
+}
+
+void benchTimestampToString(State& state) {
+    std::mt19937_64 rng(SEED + 3);
+    std::uniform_int_distribution<std::int64_t> dist(0, 4102444800LL);  // 1970..2100
+    std::vector<Timestamp> stamps;
+    stamps.reserve(PATTERN_LENGTH);
+    for (size_t i = 0; i < PATTERN_LENGTH; ++i) {
+        stamps.push_back(Timestamp::fromTimeT(static_cast<std::time_t>(dist(rng))));
+    }
+
+    size_t i = 0;
+    while (state.keepRunning()) {
+        doNotOptimize(stamps[i++ & (PATTERN_LENGTH - 1)].toString());
+    }
+    state.setItemsProcessed(state.getIterations());
+}
+
+std::vector<Benchmark> registerBenchmarks() {
+    std::vector<Benchmark> benchmarks = {
+        {"BM_BankSystem_Deposit", benchDeposit, 0},
+        {"BM_BankSystem_DepositWithLedger", benchDepositWithLedger, 0},
+        {"BM_BankSystem_Withdraw", benchWithdraw, 0},
+        {"BM_BankSystem_Transfer", benchTransfer, 0},
+        {"BM_BankSystem_DepositDuringCheckpoint", benchDepositDuringCheckpoint, 0},
+        {"BM_PasswordHasher_Hash", benchPasswordHash, 0},
+        {"BM_PasswordHasher_Verify", benchPasswordVerify, 0},
+        {"BM_Timestamp_ToString", benchTimestampToString, 0},
+        {"BM_Transaction_Record", benchTransactionRecord, 0},
+        {"BM_Transaction_FormatTo", benchTransactionFormatTo, 0},
+    };
+
+    for (size_t count : {size_t(1000), size_t(100000)}) {
+        benchmarks.push_back({"BM_AccountRepository_GetByAccountNo/" + std::to_string(count),
+                              [count](State& state) { benchGetByAccountNo(state, count); }, 0});
+        benchmarks.push_back({"BM_AccountRepository_FindByOwnerId/" + std::to_string(count),
+                              [count](State& state) { benchFindByOwnerId(state, count); }, 0});
+    }
+
+    for (size_t count : {size_t(100000)}) {
+        benchmarks.push_back({"BM_InterestEngine_ApplyAll/" + std::to_string(count),
+                              [count](State& state) { benchInterestEngineApplyAll(state, count); }, 0});
+        benchmarks.push_back({"BM_Ledger_Totals/" + std::to_string(count),
+                              [count](State& state) { benchLedgerTotals(state, count); }, 0});
+        benchmarks.push_back({"BM_BankAnalytics_Summarize/" + std::to_string(count),
+                              [count](State& state) { benchAnalyticsSummarize(state, count); }, 0});
+        benchmarks.push_back({"BM_BankAnalytics_Histogram/" + std::to_string(count),
+                              [count](State& state) { benchAnalyticsHistogram(state, count); }, 0});
+        benchmarks.push_back({"BM_BankSystem_HistoryRange/" + std::to_string(count),
+                              [count](State& state) { benchHistoryRange(state, count); }, 0});
+        benchmarks.push_back({"BM_StatementGenerator_WriteCombined/" + std::to_string(count),
+                              [count](State& state) { benchStatementsCombined(state, count); }, 0});
+    }
+
+    // Large snapshots run a fixed number of times; setup dominates otherwise
+    for (size_t count : {size_t(1000), size_t(100000), size_t(1000000)}) {
+        std::uint64_t iterations = count >= 1000000 ? 3 : 0;
+        benchmarks.push_back({"BM_DataPersistence_SaveAccounts/" + std::to_string(count),
+                              [count](State& state) { benchSaveAccounts(state, count); }, iterations});
+        benchmarks.push_back({"BM_DataPersistence_LoadAccounts/" + std::to_string(count),
+                              [count](State& state) { benchLoadAccounts(state, count); }, iterations});
+        benchmarks.push_back({"BM_DataPersistence_CheckpointAccounts/" + std::to_string(count),
+                              [count](State& state) { benchCheckpointAccounts(state, count); }, 0});
+    }
+    return benchmarks;
+}
+
+// ===== Runner =====
+
+Result runBenchmark(const Benchmark& benchmark, double minTime) {
+    std::uint64_t iterations = benchmark.fixedIterations != 0 ? benchmark.fixedIterations : 1;
+
+    for (;;) {
+        State state(iterations);
+        benchmark.function(state);
+        double seconds = state.getSeconds();
+
+        bool done = benchmark.fixedIterations != 0 || seconds >= minTime ||
+                    iterations >= 1000000000ULL;
+        if (done) {
+            Result result;
+            result.name = benchmark.name;
+            result.iterations = iterations;
+            result.nanosPerIteration = seconds * 1e9 / static_cast<double>(iterations);
+            result.itemsPerSecond = seconds > 0
+                ? static_cast<double>(state.getItemsProcessed()) / seconds : 0.0;
+            return result;
+        }
+
+        // Same growth rule as Google Benchmark: aim 40% past the target,
+        // but never grow more than 10x per round
+        double multiplier = seconds > 0 ? minTime * 1.4 / seconds : 10.0;
+        multiplier = std::min(std::max(multiplier, 2.0), 10.0);
+        iterations = static_cast<std::uint64_t>(static_cast<double>(iterations) * multiplier);
+    }
+}
+
+std::string jsonEscape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out;
+}
+
+void writeJson(std::FILE* out, const std::vector<Result>& results) {
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::gmtime(&now));
+
+    std::fprintf(out, "{\n  \"context\": {\n");
+    std::fprintf(out, "    \"date\": \"%s\",\n", date);
+    std::fprintf(out, "    \"executable\": \"bank_bench\",\n");
+    std::fprintf(out, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+#ifdef NDEBUG
+    std::fprintf(out, "    \"library_build_type\": \"release\"\n");
+#else
+    std::fprintf(out, "    \"library_build_type\": \"debug\"\n");
+#endif
+    std::fprintf(out, "  },\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::fprintf(out,
+                     "    {\n"
+                     "      \"name\": \"%s\",\n"
+                     "      \"run_type\": \"iteration\",\n"
+                     "      \"iterations\": %llu,\n"
+                     "      \"real_time\": %.3f,\n"
+                     "      \"time_unit\": \"ns\",\n"
+                     "      \"items_per_second\": %.3f\n"
+                     "    }%s\n",
+                     jsonEscape(r.name).c_str(), static_cast<unsigned long long>(r.iterations),
+                     r.nanosPerIteration, r.itemsPerSecond, i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+}
+
+void writeCsv(std::FILE* out, const std::vector<Result>& results) {
+    std::fprintf(out, "name,iterations,real_time,time_unit,items_per_second\n");
+    for (const Result& r : results) {
+        std::fprintf(out, "\"%s\",%llu,%.3f,ns,%.3f\n", r.name.c_str(),
+                     static_cast<unsigned long long>(r.iterations),
+                     r.nanosPerIteration, r.itemsPerSecond);
+    }
+}
+
+void printConsoleRow(const Result& r) {
+    std::printf("%-48s %14.1f ns %12llu %14.0f items/s\n", r.name.c_str(), r.nanosPerIteration,
+                static_cast<unsigned long long>(r.iterations), r.itemsPerSecond);
+    std::fflush(stdout);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string filter;
+    std::string format = "console";
+    std::string outPath;
+    double minTime = 0.5;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--filter=", 0) == 0) {
+            filter = arg.substr(9);
+        } else if (arg.rfind("--min-time=", 0) == 0) {
+            minTime = std::stod(arg.substr(11));
+        } else if (arg.rfind("--format=", 0) == 0) {
+            format = arg.substr(9);
+        } else if (arg.rfind("--out=", 0) == 0) {
+            outPath = arg.substr(6);
+        } else {
+            std::cerr << "Usage: bank_bench [--filter=substring] [--min-time=seconds]"
+                      << " [--format=console|json|csv] [--out=file]" << std::endl;
+            return 1;
+        }
+    }
+    if (format != "console" && format != "json" && format != "csv") {
+        std::cerr << "Unknown format: " << format << std::endl;
+        return 1;
+    }
+
+    // DataPersistence reports loads/saves on stdout; keep it off the results
+    std::FILE* out = stdout;
+    if (!outPath.empty()) {
+        out = std::fopen(outPath.c_str(), "w");
+        if (out == nullptr) {
+            std::cerr << "Cannot open output file: " << outPath << std::endl;
+            return 1;
+        }
+    }
+    std::cout.setstate(std::ios::failbit);
+
+    std::vector<Result> results;
+    for (const Benchmark& benchmark : registerBenchmarks()) {
+        if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        results.push_back(runBenchmark(benchmark, minTime));
+        if (format == "console") {
+            printConsoleRow(results.back());
+        }
+    }
+
+    if (format == "json") {
+        writeJson(out, results);
+    } else if (format == "csv") {
+        writeCsv(out, results);
+    }
+
+    if (out != stdout) {
+        std::fclose(out);
+    }
+    return 0;
+}
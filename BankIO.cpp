@@ -0,0 +1,1136 @@
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "AccountFactory.h"
+#include "AccountRepository.h"
+#include "BankSystem.h"
+#include "ChequingAccount.h"
+#include "DataPersistence.h"
+#include "OutputBuffer.h"
+#include "PostingInstruction.h"
+#include "SavingsAccount.h"
+#include "TFSAAccount.h"
+#include "StatementGenerator.h"
+#include "ThreadPool.h"
+#include "TransactionJournal.h"
+#include "User.h"
+#include "UserRepository.h"
+
+/**
+ * bank_io - Streaming import/export of accounts, users and postings
+ *
+ * Reads and writes CSV (with a header row) or NDJSON (one flat JSON object
+ * per line). Input is consumed in fixed-size chunks and parsed in place
+ * with from_chars-style parsers, so memory use does not grow with the file
+ * size beyond the records that are kept; output goes through a large write
+ * buffer. Postings are applied in bounded batches through
+ * BankSystem::postBatch.
+ *
+ * Imports load the current snapshot (and replay the journal) first and
+ * checkpoint at the end, exactly like BankingApp does.
+ *
+ * Usage: bank_io <command> <file|-> [--format=csv|ndjson] [--accounts=file]
+ *                [--users=file] [--journal=file] [--batch=postings]
+ *                [--from=YYYY-MM-DD] [--to=YYYY-MM-DD]
+ *   commands: import-accounts, export-accounts, import-users, export-users,
+ *             import-postings, statements
+ */
+
+namespace {
+
+enum class Format {
+    Csv,
+    Ndjson
+};
+
+// ===== Buffered I/O =====
+
+// Reads a file (or stdin) in large chunks and hands out one record at a time
+class ChunkedReader {
+private:
+    std::FILE* file = nullptr;
+    bool ownsFile = false;
+    std::vector<char> buffer;
+    size_t begin = 0;       // Start of the unread data
+    size_t end = 0;         // End of the valid data
+    bool atEof = false;
+    size_t lineNumber = 0;
+    bool tooLong = false;   // The last record hit MAX_RECORD_SIZE
+
+    // Move unread data to the front and read more; false at end of input
+    bool refill() {
+        if (atEof) {
+            return false;
+        }
+        if (begin > 0) {
+            std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+            end -= begin;
+            begin = 0;
+        }
+        if (end == buffer.size()) {
+            buffer.resize(buffer.size() * 2);  // A single record longer than the buffer
+        }
+        size_t got = std::fread(buffer.data() + end, 1, buffer.size() - end, file);
+        end += got;
+        if (got == 0) {
+            atEof = true;
+        }
+        return got > 0;
+    }
+
+    // Give up on an over-long record: it ends at its first line break (an
+    // unmatched quote swallows every line after it), or, for a single huge
+    // line, input is dropped up to the next line break
+    void skipOversized() {
+        tooLong = true;
+        ++lineNumber;
+        for (;;) {
+            const char* lineEnd = static_cast<const char*>(
+                std::memchr(buffer.data() + begin, '\n', end - begin));
+            if (lineEnd != nullptr) {
+                begin = static_cast<size_t>(lineEnd - buffer.data()) + 1;
+                return;
+            }
+            begin = end;
+            if (!refill()) {
+                return;
+            }
+        }
+    }
+
+public:
+    static constexpr size_t CHUNK_SIZE = 1 << 20;
+
+    // Longest record accepted; keeps memory bounded on malformed input
+    static constexpr size_t MAX_RECORD_SIZE = 4 * CHUNK_SIZE;
+
+    ~ChunkedReader() {
+        if (ownsFile) {
+            std::fclose(file);
+        }
+    }
+
+    bool open(const std::string& path) {
+        buffer.resize(CHUNK_SIZE);
+        if (path == "-") {
+            file = stdin;
+            return true;
+        }
+        file = std::fopen(path.c_str(), "rb");
+        ownsFile = (file != nullptr);
+        return file != nullptr;
+    }
+
+    // Next record without its line ending; with quoteAware, newlines inside
+    // double quotes belong to the record (CSV). The view stays valid until
+    // the next call. A record longer than MAX_RECORD_SIZE comes back empty,
+    // with wasTooLong() set.
+    bool next(std::string_view& record, bool quoteAware) {
+        size_t scan = begin;
+        bool quoted = false;
+        size_t newlines = 0;
+        tooLong = false;
+
+        for (;;) {
+            for (; scan < end; ++scan) {
+                char c = buffer[scan];
+                if (c == '"' && quoteAware) {
+                    quoted = !quoted;
+                } else if (c == '\n') {
+                    ++newlines;
+                    if (!quoted) {
+                        break;
+                    }
+                }
+            }
+
+            if (scan < end) {
+                size_t last = scan;
+                if (last > begin && buffer[last - 1] == '\r') {
+                    --last;
+                }
+                record = std::string_view(buffer.data() + begin, last - begin);
+                begin = scan + 1;
+                lineNumber += newlines;
+                return true;
+            }
+
+            size_t scanned = scan - begin;
+            if (scanned >= MAX_RECORD_SIZE) {
+                skipOversized();
+                record = std::string_view();
+                return true;
+            }
+            if (!refill()) {
+                if (begin == end) {
+                    return false;
+                }
+                // Final record without a trailing newline
+                record = std::string_view(buffer.data() + begin, end - begin);
+                begin = end;
+                lineNumber += newlines + 1;
+                return true;
+            }
+            scan = begin + scanned;
+        }
+    }
+
+    size_t getLineNumber() const {
+        return lineNumber;
+    }
+
+    bool wasTooLong() const {
+        return tooLong;
+    }
+};
+
+// ===== Record formats =====
+
+// Split a CSV record; quoted fields are unescaped into scratch, which is
+// reserved up front so earlier field views stay valid
+bool splitCsv(std::string_view record, std::vector<std::string_view>& fields,
+              std::string& scratch) {
+    fields.clear();
+    scratch.clear();
+    scratch.reserve(record.size());
+
+    size_t i = 0;
+    for (;;) {
+        if (i < record.size() && record[i] == '"') {
+            size_t start = scratch.size();
+            ++i;
+            for (;;) {
+                if (i >= record.size()) {
+                    return false;  // Unterminated quote
+                }
+                if (record[i] == '"') {
+                    if (i + 1 < record.size() && record[i + 1] == '"') {
+                        scratch += '"';
+                        i += 2;
+                        continue;
+                    }
+                    ++i;
+                    break;
+                }
+                scratch += record[i++];
+            }
+            fields.emplace_back(scratch.data() + start, scratch.size() - start);
+            if (i < record.size() && record[i] != ',') {
+                return false;  // Text after closing quote
+            }
+        } else {
+            size_t comma = record.find(',', i);
+            size_t stop = comma == std::string_view::npos ? record.size() : comma;
+            fields.push_back(record.substr(i, stop - i));
+            i = stop;
+        }
+
+        if (i >= record.size()) {
+            return true;
+        }
+        ++i;  // Skip the comma
+    }
+}
+
+void appendUtf8(std::string& out, unsigned codePoint) {
+    if (codePoint < 0x80) {
+        out += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        out += static_cast<char>(0xC0 | (codePoint >> 6));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        out += static_cast<char>(0xE0 | (codePoint >> 12));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+// Parse a flat JSON object whose values are strings, numbers, booleans or
+// null. Strings are unescaped into scratch (reserved up front).
+class JsonObjectParser {
+private:
+    const char* p;
+    const char* last;
+    std::string& scratch;
+
+    void skipSpace() {
+        while (p != last && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) {
+            ++p;
+        }
+    }
+
+    bool parseString(std::string_view& out) {
+        if (p == last || *p != '"') {
+            return false;
+        }
+        ++p;
+        size_t start = scratch.size();
+        while (p != last && *p != '"') {
+            char c = *p++;
+            if (c != '\\') {
+                scratch += c;
+                continue;
+            }
+            if (p == last) {
+                return false;
+            }
+            char escape = *p++;
+            switch (escape) {
+                case '"': scratch += '"'; break;
+                case '\\': scratch += '\\'; break;
+                case '/': scratch += '/'; break;
+                case 'b': scratch += '\b'; break;
+                case 'f': scratch += '\f'; break;
+                case 'n': scratch += '\n'; break;
+                case 'r': scratch += '\r'; break;
+                case 't': scratch += '\t'; break;
+                case 'u': {
+                    unsigned codePoint = 0;
+                    if (last - p < 4) {
+                        return false;
+                    }
+                    auto result = std::from_chars(p, p + 4, codePoint, 16);
+                    if (result.ptr != p + 4) {
+                        return false;
+                    }
+                    p += 4;
+                    appendUtf8(scratch, codePoint);
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+        if (p == last) {
+            return false;
+        }
+        ++p;  // Closing quote
+        out = std::string_view(scratch.data() + start, scratch.size() - start);
+        return true;
+    }
+
+    // Number, true, false or null: the raw token (null becomes empty)
+    bool parseLiteral(std::string_view& out) {
+        const char* start = p;
+        while (p != last && *p != ',' && *p != '}' && *p != ' ' && *p != '\t') {
+            ++p;
+        }
+        out = std::string_view(start, static_cast<size_t>(p - start));
+        if (out == "null") {
+            out = std::string_view();
+        }
+        return !out.empty() || p != start;
+    }
+
+public:
+    JsonObjectParser(std::string_view record, std::string& scratch)
+        : p(record.data()), last(record.data() + record.size()), scratch(scratch) {
+        scratch.clear();
+        scratch.reserve(record.size());
+    }
+
+    bool parse(std::vector<std::pair<std::string_view, std::string_view>>& members) {
+        members.clear();
+        skipSpace();
+        if (p == last || *p != '{') {
+            return false;
+        }
+        ++p;
+        skipSpace();
+        if (p != last && *p == '}') {
+            return true;
+        }
+
+        for (;;) {
+            std::string_view key;
+            std::string_view value;
+            skipSpace();
+            if (!parseString(key)) {
+                return false;
+            }
+            skipSpace();
+            if (p == last || *p != ':') {
+                return false;
+            }
+            ++p;
+            skipSpace();
+            bool ok = (p != last && *p == '"') ? parseString(value) : parseLiteral(value);
+            if (!ok) {
+                return false;
+            }
+            members.emplace_back(key, value);
+
+            skipSpace();
+            if (p == last) {
+                return false;
+            }
+            if (*p == '}') {
+                return true;
+            }
+            if (*p != ',') {
+                return false;
+            }
+            ++p;
+        }
+    }
+};
+
+// Field list of one record kind; numeric fields are written unquoted in NDJSON
+struct Schema {
+    std::vector<const char*> fields;
+    std::vector<bool> numeric;
+};
+
+const Schema ACCOUNT_SCHEMA = {
+    {"account_no", "owner_id", "type", "balance", "overdraft_limit", "interest_rate"},
+    {false, false, false, false, false, true}};
+
+const Schema USER_SCHEMA = {
+    {"user_id", "name", "email", "password_hash"},
+    {false, false, false, false}};
+
+const Schema POSTING_SCHEMA = {
+    {"kind", "account_no", "to_account_no", "amount"},
+    {false, false, false, false}};
+
+// Yields records as values ordered by the schema (missing fields are empty)
+class RecordReader {
+private:
+    ChunkedReader reader;
+    Format format;
+    const Schema& schema;
+    std::vector<int> columnToField;     // CSV: schema index per column (-1 = ignored)
+    bool headerChecked = false;
+
+    std::vector<std::string_view> fields;
+    std::vector<std::pair<std::string_view, std::string_view>> members;
+    std::string scratch;
+    std::string error;
+
+    int fieldIndex(std::string_view name) const {
+        for (size_t i = 0; i < schema.fields.size(); ++i) {
+            if (name == schema.fields[i]) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    bool mapCsv(std::vector<std::string_view>& values) {
+        if (!headerChecked) {
+            headerChecked = true;
+            // A header row names the columns; without one, schema order is used
+            if (!fields.empty() && fieldIndex(fields[0]) >= 0) {
+                for (std::string_view name : fields) {
+                    columnToField.push_back(fieldIndex(name));
+                }
+                return false;
+            }
+            for (size_t i = 0; i < schema.fields.size(); ++i) {
+                columnToField.push_back(static_cast<int>(i));
+            }
+        }
+        for (size_t column = 0; column < fields.size() && column < columnToField.size(); ++column) {
+            if (columnToField[column] >= 0) {
+                values[static_cast<size_t>(columnToField[column])] = fields[column];
+            }
+        }
+        return true;
+    }
+
+public:
+    RecordReader(Format format, const Schema& schema) : format(format), schema(schema) {}
+
+    bool open(const std::string& path) {
+        return reader.open(path);
+    }
+
+    // Next record; false at end of input. Malformed records set
+    // getError() and return true with ok = false.
+    bool next(std::vector<std::string_view>& values, bool& ok) {
+        std::string_view record;
+        for (;;) {
+            if (!reader.next(record, format == Format::Csv)) {
+                return false;
+            }
+            if (reader.wasTooLong()) {
+                values.assign(schema.fields.size(), std::string_view());
+                ok = false;
+                error = "record longer than " + std::to_string(ChunkedReader::MAX_RECORD_SIZE) +
+                        " bytes (unmatched quote?)";
+                return true;
+            }
+            if (record.find_first_not_of(" \t") == std::string_view::npos) {
+                continue;  // Blank line
+            }
+
+            values.assign(schema.fields.size(), std::string_view());
+            ok = true;
+
+            if (format == Format::Csv) {
+                if (!splitCsv(record, fields, scratch)) {
+                    ok = false;
+                    error = "malformed CSV record";
+                    return true;
+                }
+                if (!mapCsv(values)) {
+                    continue;  // Header row
+                }
+                return true;
+            }
+
+            JsonObjectParser parser(record, scratch);
+            if (!parser.parse(members)) {
+                ok = false;
+                error = "malformed JSON object";
+                return true;
+            }
+            for (const auto& member : members) {
+                int index = fieldIndex(member.first);
+                if (index >= 0) {
+                    values[static_cast<size_t>(index)] = member.second;
+                }
+            }
+            return true;
+        }
+    }
+
+    size_t getLineNumber() const {
+        return reader.getLineNumber();
+    }
+
+    const std::string& getError() const {
+        return error;
+    }
+};
+
+// Writes records in the chosen format
+class RecordWriter {
+private:
+    OutputBuffer writer;
+    Format format;
+    const Schema& schema;
+
+    void writeCsvField(std::string_view value) {
+        if (value.find_first_of(",\"\r\n") == std::string_view::npos) {
+            writer.append(value);
+            return;
+        }
+        writer.put('"');
+        for (char c : value) {
+            if (c == '"') {
+                writer.put('"');
+            }
+            writer.put(c);
+        }
+        writer.put('"');
+    }
+
+    void writeJsonString(std::string_view value) {
+        static const char HEX_DIGITS[] = "0123456789abcdef";
+        writer.put('"');
+        for (char c : value) {
+            unsigned char u = static_cast<unsigned char>(c);
+            if (c == '"' || c == '\\') {
+                writer.put('\\');
+                writer.put(c);
+            } else if (u < 0x20) {
+                char escape[6] = {'\\', 'u', '0', '0', HEX_DIGITS[u >> 4], HEX_DIGITS[u & 0xF]};
+                writer.append(std::string_view(escape, sizeof(escape)));
+            } else {
+                writer.put(c);
+            }
+        }
+        writer.put('"');
+    }
+
+public:
+    RecordWriter(Format format, const Schema& schema) : format(format), schema(schema) {}
+
+    bool open(const std::string& path) {
+        if (!writer.open(path)) {
+            return false;
+        }
+        if (format == Format::Csv) {
+            for (size_t i = 0; i < schema.fields.size(); ++i) {
+                if (i > 0) {
+                    writer.put(',');
+                }
+                writer.append(schema.fields[i]);
+            }
+            writer.put('\n');
+        }
+        return true;
+    }
+
+    void write(const std::vector<std::string_view>& values) {
+        if (format == Format::Csv) {
+            for (size_t i = 0; i < values.size(); ++i) {
+                if (i > 0) {
+                    writer.put(',');
+                }
+                writeCsvField(values[i]);
+            }
+            writer.put('\n');
+            return;
+        }
+
+        writer.put('{');
+        bool first = true;
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (values[i].empty()) {
+                continue;
+            }
+            if (!first) {
+                writer.put(',');
+            }
+            first = false;
+            writeJsonString(schema.fields[i]);
+            writer.put(':');
+            if (schema.numeric[i]) {
+                writer.append(values[i]);
+            } else {
+                writeJsonString(values[i]);
+            }
+        }
+        writer.append("}\n");
+    }
+
+    bool close() {
+        return writer.close();
+    }
+};
+
+// ===== Field parsing =====
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+               return std::tolower(static_cast<unsigned char>(x)) ==
+                      std::tolower(static_cast<unsigned char>(y));
+           });
+}
+
+bool parseMoney(std::string_view text, Money& out) {
+    return !text.empty() && Money::parse(text.data(), text.data() + text.size(), out);
+}
+
+bool parseRate(std::string_view text, double& out) {
+    auto result = std::from_chars(text.data(), text.data() + text.size(), out);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size() && out >= 0;
+}
+
+// "YYYY-MM-DD", local midnight
+bool parseDate(std::string_view text, Timestamp& out) {
+    int year = 0;
+    int month = 0;
+    int day = 0;
+    const char* end = text.data() + text.size();
+    auto yearResult = std::from_chars(text.data(), end, year);
+    if (yearResult.ec != std::errc() || yearResult.ptr == end || *yearResult.ptr != '-') {
+        return false;
+    }
+    auto monthResult = std::from_chars(yearResult.ptr + 1, end, month);
+    if (monthResult.ec != std::errc() || monthResult.ptr == end || *monthResult.ptr != '-') {
+        return false;
+    }
+    auto dayResult = std::from_chars(monthResult.ptr + 1, end, day);
+    if (dayResult.ec != std::errc() || dayResult.ptr != end ||
+        month < 1 || month > 12 || day < 1 || day > 31) {
+        return false;
+    }
+    out = Timestamp(year, month, day);
+    return true;
+}
+
+// ===== Commands =====
+
+struct Options {
+    Format format = Format::Csv;
+    bool formatGiven = false;
+    std::string accountsFile = "accounts.dat";
+    std::string usersFile = "users.dat";
+    std::string journalFile = "transactions.journal";
+    size_t batchSize = 65536;
+    std::string from;               // Statement period, "YYYY-MM-DD" (default: last month)
+    std::string to;
+};
+
+// Counters reported at the end of an import
+struct ImportStats {
+    size_t accepted = 0;
+    size_t rejected = 0;
+
+    void reject(size_t line, const std::string& reason) {
+        ++rejected;
+        std::cerr << "line " << line << ": " << reason << std::endl;
+    }
+};
+
+// Snapshot plus journal, as BankingApp loads them at startup
+bool loadAccountState(AccountRepository& repository, AccountFactory& factory,
+                      DataPersistence& persistence, TransactionJournal& journal,
+                      const Options& options) {
+    if (persistence.accountsFileExists()) {
+        if (!persistence.loadAccounts(repository, factory)) {
+            return false;
+        }
+    }
+    if (journal.open(options.journalFile)) {
+        journal.replay(repository, factory);
+    }
+    factory.updateCounterFromLoadedAccounts(repository);
+    // Single-threaded so far: free the accounts the replay removed
+    repository.reclaimRemoved();
+    return true;
+}
+
+// Checkpoint covering everything; the journal is then redundant
+bool saveAccountState(AccountRepository& repository, DataPersistence& persistence,
+                      TransactionJournal& journal) {
+    if (!persistence.checkpointAccounts(repository)) {
+        return false;
+    }
+    if (journal.isOpen()) {
+        journal.reset();
+    }
+    return true;
+}
+
+Account* accountFromRecord(const std::vector<std::string_view>& values, std::string& reason) {
+    std::string accountNo(values[0]);
+    std::string ownerId(values[1]);
+    if (accountNo.empty() || ownerId.empty()) {
+        reason = "account_no and owner_id are required";
+        return nullptr;
+    }
+
+    Money balance;
+    if (!parseMoney(values[3], balance)) {
+        reason = "invalid balance";
+        return nullptr;
+    }
+
+    std::string_view type = values[2];
+    bool tfsa = equalsIgnoreCase(type, "TFSA");
+    if (tfsa || equalsIgnoreCase(type, "Savings")) {
+        double rate = 0.02;
+        if (!values[5].empty() && !parseRate(values[5], rate)) {
+            reason = "invalid interest_rate";
+            return nullptr;
+        }
+        if (balance.isNegative()) {
+            reason = "savings balance cannot be negative";
+            return nullptr;
+        }
+        if (tfsa) {
+            return new TFSAAccount(accountNo, ownerId, balance, rate);
+        }
+        return new SavingsAccount(accountNo, ownerId, balance, rate);
+    }
+
+    if (equalsIgnoreCase(type, "Chequing")) {
+        Money overdraft = Money::fromUnits(500);
+        if (!values[4].empty() && !parseMoney(values[4], overdraft)) {
+            reason = "invalid overdraft_limit";
+            return nullptr;
+        }
+        // Overdrawn balances are legal for chequing; set them after construction
+        auto* account = new ChequingAccount(accountNo, ownerId, Money(), overdraft);
+        account->restoreBalance(balance);
+        return account;
+    }
+
+    reason = "unknown account type";
+    return nullptr;
+}
+
+int importAccounts(const std::string& input, const Options& options) {
+    RecordReader reader(options.format, ACCOUNT_SCHEMA);
+    if (!reader.open(input)) {
+        std::cerr << "Cannot open input: " << input << std::endl;
+        return 2;
+    }
+
+    AccountRepository repository;
+    AccountFactory factory;
+    DataPersistence persistence(options.accountsFile, options.usersFile);
+    TransactionJournal journal;
+    if (!loadAccountState(repository, factory, persistence, journal, options)) {
+        return 2;
+    }
+
+    ImportStats stats;
+    std::vector<std::string_view> values;
+    std::string reason;
+    bool ok;
+    while (reader.next(values, ok)) {
+        if (!ok) {
+            stats.reject(reader.getLineNumber(), reader.getError());
+            continue;
+        }
+        if (repository.existsAccountNo(std::string(values[0]))) {
+            stats.reject(reader.getLineNumber(), "account already exists: " + std::string(values[0]));
+            continue;
+        }
+        Account* account = accountFromRecord(values, reason);
+        if (account == nullptr) {
+            stats.reject(reader.getLineNumber(), reason);
+            continue;
+        }
+        repository.save(account);
+        ++stats.accepted;
+    }
+
+    if (!saveAccountState(repository, persistence, journal)) {
+        return 2;
+    }
+    std::cerr << "Imported " << stats.accepted << " accounts, rejected " << stats.rejected
+              << std::endl;
+    return stats.rejected == 0 ? 0 : 1;
+}
+
+int exportAccounts(const std::string& output, const Options& options) {
+    AccountRepository repository;
+    AccountFactory factory;
+    DataPersistence persistence(options.accountsFile, options.usersFile);
+    TransactionJournal journal;
+    if (!loadAccountState(repository, factory, persistence, journal, options)) {
+        return 2;
+    }
+
+    RecordWriter writer(options.format, ACCOUNT_SCHEMA);
+    if (!writer.open(output)) {
+        std::cerr << "Cannot open output: " << output << std::endl;
+        return 2;
+    }
+
+    char balanceText[Money::MAX_CHARS];
+    char overdraftText[Money::MAX_CHARS];
+    char rateText[32];
+    std::vector<std::string_view> values(ACCOUNT_SCHEMA.fields.size());
+    size_t exported = 0;
+
+    for (Account* account : repository.getAllAccounts()) {
+        values.assign(values.size(), std::string_view());
+        values[0] = account->getAccountNo();
+        values[1] = account->getOwnerId();
+
+        std::lock_guard<std::mutex> lock(account->getMutex());
+        char* balanceEnd = account->getBalance().toChars(balanceText, balanceText + sizeof(balanceText));
+        values[3] = std::string_view(balanceText, static_cast<size_t>(balanceEnd - balanceText));
+
+        if (auto* savings = dynamic_cast<SavingsAccount*>(account)) {
+            values[2] = dynamic_cast<TFSAAccount*>(account) != nullptr ? "TFSA" : "Savings";
+            auto result = std::to_chars(rateText, rateText + sizeof(rateText), savings->getInterestRate());
+            values[5] = std::string_view(rateText, static_cast<size_t>(result.ptr - rateText));
+        } else if (auto* chequing = dynamic_cast<ChequingAccount*>(account)) {
+            values[2] = "Chequing";
+            char* end = chequing->getOverdraftLimit().toChars(overdraftText,
+                                                              overdraftText + sizeof(overdraftText));
+            values[4] = std::string_view(overdraftText, static_cast<size_t>(end - overdraftText));
+        } else {
+            continue;
+        }
+
+        writer.write(values);
+        ++exported;
+    }
+
+    if (!writer.close()) {
+        std::cerr << "Write failed: " << output << std::endl;
+        return 2;
+    }
+    std::cerr << "Exported " << exported << " accounts" << std::endl;
+    return 0;
+}
+
+int importUsers(const std::string& input, const Options& options) {
+    RecordReader reader(options.format, USER_SCHEMA);
+    if (!reader.open(input)) {
+        std::cerr << "Cannot open input: " << input << std::endl;
+        return 2;
+    }
+
+    UserRepository users;
+    DataPersistence persistence(options.accountsFile, options.usersFile);
+    if (persistence.usersFileExists() && !persistence.loadUsers(users)) {
+        return 2;
+    }
+
+    ImportStats stats;
+    std::vector<std::string_view> values;
+    bool ok;
+    while (reader.next(values, ok)) {
+        if (!ok) {
+            stats.reject(reader.getLineNumber(), reader.getError());
+            continue;
+        }
+        std::string userId(values[0]);
+        if (userId.empty() || values[3].empty()) {
+            stats.reject(reader.getLineNumber(), "user_id and password_hash are required");
+            continue;
+        }
+        if (users.existsUserId(userId)) {
+            stats.reject(reader.getLineNumber(), "user already exists: " + userId);
+            continue;
+        }
+        users.save(User(userId, std::string(values[1]), std::string(values[2]),
+                        std::string(values[3])));
+        ++stats.accepted;
+    }
+
+    if (!persistence.checkpointUsers(users)) {
+        return 2;
+    }
+    std::cerr << "Imported " << stats.accepted << " users, rejected " << stats.rejected
+              << std::endl;
+    return stats.rejected == 0 ? 0 : 1;
+}
+
+int exportUsers(const std::string& output, const Options& options) {
+    UserRepository users;
+    DataPersistence persistence(options.accountsFile, options.usersFile);
+    if (persistence.usersFileExists() && !persistence.loadUsers(users)) {
+        return 2;
+    }
+
+    RecordWriter writer(options.format, USER_SCHEMA);
+    if (!writer.open(output)) {
+        std::cerr << "Cannot open output: " << output << std::endl;
+        return 2;
+    }
+
+    size_t exported = 0;
+    for (const User& user : users.getAllUsers()) {
+        std::string userId = user.getUserId();
+        std::string name = user.getName();
+        std::string email = user.getEmail();
+        std::string passwordHash = user.getPasswordHash();
+        writer.write({userId, name, email, passwordHash});
+        ++exported;
+    }
+
+    if (!writer.close()) {
+        std::cerr << "Write failed: " << output << std::endl;
+        return 2;
+    }
+    std::cerr << "Exported " << exported << " users" << std::endl;
+    return 0;
+}
+
+int importPostings(const std::string& input, const Options& options) {
+    RecordReader reader(options.format, POSTING_SCHEMA);
+    if (!reader.open(input)) {
+        std::cerr << "Cannot open input: " << input << std::endl;
+        return 2;
+    }
+
+    AccountRepository repository;
+    AccountFactory factory;
+    BankSystem bank(repository, factory);
+    DataPersistence persistence(options.accountsFile, options.usersFile);
+    TransactionJournal journal;
+    if (!loadAccountState(repository, factory, persistence, journal, options)) {
+        return 2;
+    }
+    bank.setHistoryArchive(&persistence.getHistoryArchive());
+    // Postings go through the write-ahead log, as in BankingApp
+    if (journal.isOpen()) {
+        bank.setJournal(&journal);
+    }
+
+    ImportStats stats;
+    std::vector<PostingInstruction> batch;
+    std::vector<size_t> batchLines;
+    batch.reserve(options.batchSize);
+    batchLines.reserve(options.batchSize);
+
+    auto flush = [&]() {
+        std::vector<PostingResult> results = bank.postBatch(batch);
+        for (size_t i = 0; i < results.size(); ++i) {
+            switch (results[i]) {
+                case PostingResult::Ok: ++stats.accepted; break;
+                case PostingResult::UnknownAccount: stats.reject(batchLines[i], "unknown account"); break;
+                case PostingResult::InvalidAmount: stats.reject(batchLines[i], "invalid amount"); break;
+                case PostingResult::InsufficientFunds: stats.reject(batchLines[i], "insufficient funds"); break;
+                case PostingResult::SameAccount: stats.reject(batchLines[i], "same account"); break;
+                case PostingResult::AmountOutOfRange: stats.reject(batchLines[i], "amount out of range"); break;
+            }
+        }
+        batch.clear();
+        batchLines.clear();
+    };
+
+    std::vector<std::string_view> values;
+    bool ok;
+    while (reader.next(values, ok)) {
+        if (!ok) {
+            stats.reject(reader.getLineNumber(), reader.getError());
+            continue;
+        }
+
+        PostingInstruction instruction;
+        if (equalsIgnoreCase(values[0], "deposit")) {
+            instruction.kind = PostingKind::Deposit;
+        } else if (equalsIgnoreCase(values[0], "withdraw")) {
+            instruction.kind = PostingKind::Withdraw;
+        } else if (equalsIgnoreCase(values[0], "transfer")) {
+            instruction.kind = PostingKind::Transfer;
+        } else {
+            stats.reject(reader.getLineNumber(), "unknown posting kind");
+            continue;
+        }
+        if (!parseMoney(values[3], instruction.amount)) {
+            stats.reject(reader.getLineNumber(), "invalid amount");
+            continue;
+        }
+        instruction.accountNo.assign(values[1].data(), values[1].size());
+        instruction.toAccountNo.assign(values[2].data(), values[2].size());
+
+        batch.push_back(std::move(instruction));
+        batchLines.push_back(reader.getLineNumber());
+        if (batch.size() >= options.batchSize) {
+            flush();
+        }
+    }
+    flush();
+
+    if (!saveAccountState(repository, persistence, journal)) {
+        return 2;
+    }
+    std::cerr << "Applied " << stats.accepted << " postings, rejected " << stats.rejected
+              << std::endl;
+    return stats.rejected == 0 ? 0 : 1;
+}
+
+// Statements for every account: one stream, or one file each if the
+// output path ends in '/'
+int writeStatements(const std::string& output, const Options& options) {
+    CivilTime today = Timestamp::now().decompose();
+    Timestamp to(today.year, today.month, 1);
+    Timestamp from(today.month == 1 ? today.year - 1 : today.year,
+                   today.month == 1 ? 12 : today.month - 1, 1);
+    if ((!options.from.empty() && !parseDate(options.from, from)) ||
+        (!options.to.empty() && !parseDate(options.to, to))) {
+        std::cerr << "Dates must be YYYY-MM-DD" << std::endl;
+        return 2;
+    }
+
+    AccountRepository repository;
+    AccountFactory factory;
+    BankSystem bank(repository, factory);
+    DataPersistence persistence(options.accountsFile, options.usersFile);
+    TransactionJournal journal;
+    if (!loadAccountState(repository, factory, persistence, journal, options)) {
+        return 2;
+    }
+    bank.setHistoryArchive(&persistence.getHistoryArchive());
+
+    StatementGenerator generator(bank, ThreadPool::shared());
+    StatementReport report = output.size() > 1 && output.back() == '/'
+        ? generator.writePerAccount(from, to, output)
+        : generator.writeCombined(from, to, output);
+
+    std::cerr << "Wrote " << report.statements << " statements (" << report.postings
+              << " postings), failed " << report.failed << std::endl;
+    return report.failed == 0 ? 0 : 2;
+}
+
+void printUsage() {
+    std::cerr << "Usage: bank_io <command> <file|-> [--format=csv|ndjson] [--accounts=file]\n"
+              << "               [--users=file] [--journal=file] [--batch=postings]\n"
+              << "               [--from=YYYY-MM-DD] [--to=YYYY-MM-DD]\n"
+              << "Commands: import-accounts, export-accounts, import-users, export-users,\n"
+              << "          import-postings, statements (output ending in '/': one file per account)"
+              << std::endl;
+}
+
+bool endsWith(const std::string& text, const char* suffix) {
+    size_t length = std::strlen(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> positional;
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--format=", 0) == 0) {
+            std::string format = arg.substr(9);
+            if (format == "csv") {
+                options.format = Format::Csv;
+            } else if (format == "ndjson") {
+                options.format = Format::Ndjson;
+            } else {
+                std::cerr << "Unknown format: " << format << std::endl;
+                return 2;
+            }
+            options.formatGiven = true;
+        } else if (arg.rfind("--accounts=", 0) == 0) {
+            options.accountsFile = arg.substr(11);
+        } else if (arg.rfind("--users=", 0) == 0) {
+            options.usersFile = arg.substr(8);
+        } else if (arg.rfind("--journal=", 0) == 0) {
+            options.journalFile = arg.substr(10);
+        } else if (arg.rfind("--batch=", 0) == 0) {
+            options.batchSize = std::max<size_t>(1, std::stoul(arg.substr(8)));
+        } else if (arg.rfind("--from=", 0) == 0) {
+            options.from = arg.substr(7);
+        } else if (arg.rfind("--to=", 0) == 0) {
+            options.to = arg.substr(5);
+        } else if (arg.rfind("--", 0) == 0) {
+            printUsage();
+            return 2;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+    if (positional.size() != 2) {
+        printUsage();
+        return 2;
+    }
+
+    const std::string& command = positional[0];
+    const std::string& path = positional[1];
+    if (!options.formatGiven && (endsWith(path, ".ndjson") || endsWith(path, ".jsonl"))) {
+        options.format = Format::Ndjson;
+    }
+
+    // DataPersistence reports loads/saves on stdout; keep exported data clean
+    if (path == "-") {
+        std::cout.setstate(std::ios::failbit);
+    }
+
+    try {
+        if (command == "import-accounts") {
+            return importAccounts(path, options);
+        } else if (command == "export-accounts") {
+            return exportAccounts(path, options);
+        } else if (command == "import-users") {
+            return importUsers(path, options);
+        } else if (command == "export-users") {
+            return exportUsers(path, options);
+        } else if (command == "import-postings") {
+            return importPostings(path, options);
+        } else if (command == "statements") {
+            return writeStatements(path, options);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Fatal error: " << e.what() << std::endl;
+        return 2;
+    }
+
+    printUsage();
+    return 2;
+}
@@ -2,92 +2,178 @@
 #include "DepositTransaction.h"
 #include "WithdrawTransaction.h"
 #include "TransferTransaction.h"
+#include "SavingsAccount.h"
+#include "ChequingAccount.h"
+#include "HistoryIndex.h"
+#include "Logger.h"
 #include <iostream>
 #include <iomanip>
+#include <mutex>
+#include <stdexcept>
 
 // Constructor
 BankSystem::BankSystem(AccountRepository& accounts, AccountFactory& factory)
-    : accounts(accounts), factory(factory) {
-    std::cout << "Bank System initialized." << std::endl;
+    : accounts(accounts), factory(factory), journal(nullptr), historyArchive(nullptr),
+      ledger(nullptr) {
+    LOG_DEBUG("Bank System initialized.");
+}
+
+// Enable/disable write-ahead journaling
+void BankSystem::setJournal(TransactionJournal* journal) {
+    this->journal = journal;
+}
+
+// Archive holding saved history
+void BankSystem::setHistoryArchive(HistoryArchive* archive) {
+    this->historyArchive = archive;
+}
+
+// Ledger mirroring the accounts
+void BankSystem::setLedger(Ledger* ledger) {
+    this->ledger = ledger;
+    if (ledger != nullptr) {
+        ledger->loadFrom(accounts);
+    }
+}
+
+// Block until the transaction's journal record is on disk
+void BankSystem::commitToJournal(const Transaction& transaction) {
+    if (journal != nullptr) {
+        journal->commit(transaction.getJournalLsn());
+    }
 }
 
 // Helper to validate account exists
 bool BankSystem::validateAccountExists(const std::string& accountNo) const {
     if (!accounts.existsAccountNo(accountNo)) {
-        std::cerr << "Error: Account " << accountNo << " not found." << std::endl;
+        LOG_DEBUG("Account ", accountNo, " not found");
         return false;
     }
     return true;
 }
 
+// Single lookup that reports unknown accounts like validateAccountExists
+Account* BankSystem::resolveAccount(const std::string& accountNo) {
+    auto optAccount = accounts.getByAccountNo(accountNo);
+    if (!optAccount.has_value()) {
+        LOG_DEBUG("Account ", accountNo, " not found");
+        return nullptr;
+    }
+    return optAccount.value();
+}
+
 // Create new account
 Account* BankSystem::createAccount(const std::string& ownerId, AccountType type,
-                                   double initialBalance, double overdraft) {
+                                   Money initialBalance, Money overdraft) {
+    Account* account = nullptr;
     try {
         // Use factory to create account
-        Account* account = factory.create(type, ownerId, initialBalance);
+        account = factory.create(type, ownerId, initialBalance);
 
         // For chequing accounts, set custom overdraft if provided
-        if (type == AccountType::Chequing && overdraft > 0.0) {
-            // We'd need to cast and set overdraft here if different from default
-            // For now, factory sets default $500 overdraft for chequing
+        if (type == AccountType::Chequing && overdraft.isPositive()) {
+            static_cast<ChequingAccount*>(account)->setOverdraftLimit(overdraft);
+        }
+
+        // Journal the new account before it becomes visible to postings
+        if (journal != nullptr) {
+            TransactionJournal::Record record;
+            record.type = TransactionJournal::RecordType::OpenAccount;
+            record.accountType = type;
+            record.accountNo = account->getAccountNo();
+            record.otherId = ownerId;
+            record.balanceAfter = account->getBalance();
+            if (auto* savings = dynamic_cast<SavingsAccount*>(account)) {
+                record.interestRate = savings->getInterestRate();
+            } else if (auto* chequing = dynamic_cast<ChequingAccount*>(account)) {
+                record.overdraftLimit = chequing->getOverdraftLimit();
+            }
+            record.timeMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            journal->commit(journal->append(record));
         }
 
         // Save to repository
         if (accounts.save(account)) {
-            std::cout << "Account created successfully: " << account->getAccountNo()
-                      << " (" << AccountFactory::accountTypeToString(type) << ")" << std::endl;
+            if (ledger != nullptr) {
+                std::lock_guard<std::mutex> lock(account->getMutex());
+                ledger->open(*account);
+            }
+            LOG_DEBUG("Account created successfully: ", account->getAccountNo(),
+                      " (", AccountFactory::accountTypeToString(type), ")");
             return account;
         } else {
             delete account;
-            std::cerr << "Failed to save account to repository." << std::endl;
+            LOG_WARN("Failed to save account to repository.");
             return nullptr;
         }
 
     } catch (const std::exception& e) {
-        std::cerr << "Error creating account: " << e.what() << std::endl;
+        delete account;
+        LOG_ERROR("Error creating account: ", e.what());
         return nullptr;
     }
 }
 
 // Delete account
 bool BankSystem::deleteAccount(const std::string& accountNo) {
-    if (!validateAccountExists(accountNo)) {
+    Account* account = resolveAccount(accountNo);
+    if (account == nullptr) {
         return false;
     }
 
-    // Check if account has balance
-    double balance = accounts.getBalance(accountNo);
-    if (balance != 0.0) {
-        std::cerr << "Cannot delete account with non-zero balance: $" << balance << std::endl;
-        std::cerr << "Please withdraw all funds first." << std::endl;
-        return false;
-    }
+    // Journal the removal before it happens, as createAccount does; the
+    // balance check and the record share the account lock, so no posting
+    // lands in the journal between them
+    std::uint64_t lsn = 0;
+    {
+        std::lock_guard<std::mutex> lock(account->getMutex());
+        Money balance = account->getBalance();
+        if (!balance.isZero()) {
+            LOG_DEBUG("Cannot delete account ", accountNo, " with non-zero balance: $", balance);
+            return false;
+        }
 
-    return accounts.remove(accountNo);
-}
+        if (journal != nullptr) {
+            TransactionJournal::Record record;
+            record.type = TransactionJournal::RecordType::CloseAccount;
+            record.accountNo = accountNo;
+            record.timeMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            lsn = journal->append(record);
+        }
+    }
 
-// Deposit money
-bool BankSystem::deposit(const std::string& accountNo, double amount) {
-    if (!validateAccountExists(accountNo)) {
+    if (journal != nullptr) {
+        journal->commit(lsn);
+    }
+    if (!accounts.remove(accountNo)) {
         return false;
     }
+    if (ledger != nullptr) {
+        ledger->close(account->getAccountHandle());
+    }
+    return true;
+}
 
-    auto optAccount = accounts.getByAccountNo(accountNo);
-    if (!optAccount.has_value()) {
+// Deposit money
+bool BankSystem::deposit(const std::string& accountNo, Money amount) {
+    Account* account = resolveAccount(accountNo);
+    if (account == nullptr) {
         return false;
     }
 
-    Account* account = optAccount.value();
-
     // Create and execute deposit transaction
     DepositTransaction transaction(*account, amount, Timestamp::now(),
                                   "Deposit via Bank System");
+    transaction.attachJournal(journal);
 
     if (transaction.execute()) {
-        std::cout << "Deposit successful: $" << std::fixed << std::setprecision(2)
-                  << amount << " to " << accountNo << std::endl;
-        std::cout << "New balance: $" << account->getBalance() << std::endl;
+        commitToJournal(transaction);
+        spillHistory(account);
+        refreshLedger(account);
+        LOG_DEBUG("Deposit successful: $", amount, " to ", accountNo,
+                  " (New balance: $", accounts.getBalance(accountNo), ")");
         return true;
     }
 
@@ -95,26 +181,23 @@ bool BankSystem::deposit(const std::string& accountNo, double amount) {
 }
 
 // Withdraw money
-bool BankSystem::withdraw(const std::string& accountNo, double amount) {
-    if (!validateAccountExists(accountNo)) {
-        return false;
-    }
-
-    auto optAccount = accounts.getByAccountNo(accountNo);
-    if (!optAccount.has_value()) {
+bool BankSystem::withdraw(const std::string& accountNo, Money amount) {
+    Account* account = resolveAccount(accountNo);
+    if (account == nullptr) {
         return false;
     }
 
-    Account* account = optAccount.value();
-
     // Create and execute withdrawal transaction
     WithdrawTransaction transaction(*account, amount, Timestamp::now(),
                                    "Withdrawal via Bank System");
+    transaction.attachJournal(journal);
 
     if (transaction.execute()) {
-        std::cout << "Withdrawal successful: $" << std::fixed << std::setprecision(2)
-                  << amount << " from " << accountNo << std::endl;
-        std::cout << "New balance: $" << account->getBalance() << std::endl;
+        commitToJournal(transaction);
+        spillHistory(account);
+        refreshLedger(account);
+        LOG_DEBUG("Withdrawal successful: $", amount, " from ", accountNo,
+                  " (New balance: $", accounts.getBalance(accountNo), ")");
         return true;
     }
 
@@ -123,39 +206,185 @@ bool BankSystem::withdraw(const std::string& accountNo, double amount) {
 
 // Transfer money between accounts
 bool BankSystem::transfer(const std::string& fromAccountNo,
-                         const std::string& toAccountNo, double amount) {
-    if (!validateAccountExists(fromAccountNo) || !validateAccountExists(toAccountNo)) {
-        return false;
-    }
+                         const std::string& toAccountNo, Money amount) {
+    Account* fromAccount = resolveAccount(fromAccountNo);
+    Account* toAccount = resolveAccount(toAccountNo);
 
-    auto optFromAccount = accounts.getByAccountNo(fromAccountNo);
-    auto optToAccount = accounts.getByAccountNo(toAccountNo);
-
-    if (!optFromAccount.has_value() || !optToAccount.has_value()) {
+    if (fromAccount == nullptr || toAccount == nullptr) {
         return false;
     }
 
-    Account* fromAccount = optFromAccount.value();
-    Account* toAccount = optToAccount.value();
-
     // Create and execute transfer transaction
     TransferTransaction transaction(*fromAccount, *toAccount, amount,
                                    Timestamp::now(), "Transfer via Bank System");
+    transaction.attachJournal(journal);
 
     if (transaction.execute()) {
-        std::cout << "Transfer successful: $" << std::fixed << std::setprecision(2)
-                  << amount << " from " << fromAccountNo
-                  << " to " << toAccountNo << std::endl;
-        std::cout << fromAccountNo << " balance: $" << fromAccount->getBalance() << std::endl;
-        std::cout << toAccountNo << " balance: $" << toAccount->getBalance() << std::endl;
+        commitToJournal(transaction);
+        spillHistory(fromAccount);
+        spillHistory(toAccount);
+        refreshLedger(fromAccount);
+        refreshLedger(toAccount);
+        LOG_DEBUG("Transfer successful: $", amount, " from ", fromAccountNo,
+                  " to ", toAccountNo);
         return true;
     }
 
     return false;
 }
 
+// Move unsaved history to the archive once it piles up, so memory stays
+// bounded between saves. The snapshot still points at the older head until
+// the next save; after a crash the journal rebuilds these entries and the
+// spilled block is simply never referenced. A checkpoint that staged the
+// same entries before the spill finds the chain moved on and leaves the
+// account alone (see Account::markHistoryArchived).
+void BankSystem::spillHistory(Account* account) {
+    if (historyArchive == nullptr) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(account->getMutex());
+    const std::vector<HistoryEntry>& unsaved = account->getHistory();
+    if (unsaved.size() < HISTORY_SPILL_ENTRIES) {
+        return;
+    }
+
+    std::uint64_t generation = historyArchive->getGeneration();
+    std::uint64_t previous = account->getHistoryHead();
+    std::uint64_t head = historyArchive->stage(previous, unsaved.data(), unsaved.size());
+    if (head != 0 && historyArchive->commit() && historyArchive->getGeneration() == generation) {
+        account->markHistoryArchived(previous, head, unsaved.size());
+    }
+}
+
+// Mirror an account into the ledger. Its lock orders the refreshes, so the
+// row ends up with the account's latest state
+void BankSystem::refreshLedger(Account* account) {
+    if (ledger == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(account->getMutex());
+    ledger->refresh(*account);
+}
+
+// Execute one batch posting; callers have validated accounts and amount
+bool BankSystem::applyPosting(const PostingInstruction& instruction, Account* source,
+                              Account* target, const Timestamp& now, std::uint64_t& lsn) {
+    switch (instruction.kind) {
+        case PostingKind::Deposit: {
+            DepositTransaction transaction(*source, instruction.amount, now, "Batch deposit");
+            transaction.attachJournal(journal);
+            bool executed = transaction.execute();
+            lsn = transaction.getJournalLsn();
+            return executed;
+        }
+        case PostingKind::Withdraw: {
+            WithdrawTransaction transaction(*source, instruction.amount, now, "Batch withdrawal");
+            transaction.attachJournal(journal);
+            bool executed = transaction.execute();
+            lsn = transaction.getJournalLsn();
+            return executed;
+        }
+        case PostingKind::Transfer: {
+            TransferTransaction transaction(*source, *target, instruction.amount, now,
+                                            "Batch transfer");
+            transaction.attachJournal(journal);
+            bool executed = transaction.execute();
+            lsn = transaction.getJournalLsn();
+            return executed;
+        }
+    }
+    return false;
+}
+
+// Apply a batch of postings
+std::vector<PostingResult> BankSystem::postBatch(const PostingInstruction* instructions,
+                                                 size_t count) {
+    std::vector<PostingResult> results(count, PostingResult::Ok);
+
+    // Resolve every account number up front (one flat-index probe each)
+    auto lookup = [&](const std::string& accountNo) -> Account* {
+        return accounts.getByAccountNo(accountNo).value_or(nullptr);
+    };
+
+    std::vector<Account*> sources(count);
+    std::vector<Account*> targets(count);
+    for (size_t i = 0; i < count; ++i) {
+        const PostingInstruction& instruction = instructions[i];
+        sources[i] = lookup(instruction.accountNo);
+        if (instruction.kind == PostingKind::Transfer) {
+            targets[i] = lookup(instruction.toAccountNo);
+        }
+    }
+
+    // Apply in input order; later postings may depend on earlier credits
+    Timestamp now = Timestamp::now();
+    std::uint64_t lastLsn = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        const PostingInstruction& instruction = instructions[i];
+        Account* source = sources[i];
+        Account* target = targets[i];
+
+        if (source == nullptr ||
+            (instruction.kind == PostingKind::Transfer && target == nullptr)) {
+            results[i] = PostingResult::UnknownAccount;
+            continue;
+        }
+        if (!instruction.amount.isPositive()) {
+            results[i] = PostingResult::InvalidAmount;
+            continue;
+        }
+        if (instruction.kind == PostingKind::Transfer && source == target) {
+            results[i] = PostingResult::SameAccount;
+            continue;
+        }
+
+        bool executed = false;
+        std::uint64_t lsn = 0;
+        try {
+            executed = applyPosting(instruction, source, target, now, lsn);
+        } catch (const std::overflow_error&) {
+            // Checked Money arithmetic; the balances were left unchanged
+            results[i] = PostingResult::AmountOutOfRange;
+            continue;
+        } catch (...) {
+            // Postings already applied must still reach the journal
+            if (journal != nullptr && lastLsn != 0) {
+                journal->commit(lastLsn);
+            }
+            throw;
+        }
+
+        if (executed) {
+            lastLsn = lsn;
+            spillHistory(source);
+            refreshLedger(source);
+            if (target != nullptr) {
+                spillHistory(target);
+                refreshLedger(target);
+            }
+        } else {
+            // Amount and accounts were validated above; only funds can fail
+            results[i] = PostingResult::InsufficientFunds;
+        }
+    }
+
+    // One durable commit covers every posting in the batch
+    if (journal != nullptr && lastLsn != 0) {
+        journal->commit(lastLsn);
+    }
+
+    return results;
+}
+
+std::vector<PostingResult> BankSystem::postBatch(const std::vector<PostingInstruction>& instructions) {
+    return postBatch(instructions.data(), instructions.size());
+}
+
 // Get account balance
-double BankSystem::getBalance(const std::string& accountNo) const {
+Money BankSystem::getBalance(const std::string& accountNo) const {
     return accounts.getBalance(accountNo);
 }
 
@@ -165,28 +394,237 @@ std::vector<std::string> BankSystem::getAccountsByOwner(const std::string& owner
 }
 
 // Get transaction history for an account
-std::vector<Transaction*> BankSystem::getTransactionHistory(const std::string& accountNo) const {
+std::vector<HistoryEntry> BankSystem::getTransactionHistory(const std::string& accountNo) const {
+    std::vector<HistoryEntry> history;
     auto optAccount = accounts.getByAccountNo(accountNo);
-    if (optAccount.has_value()) {
-        const std::vector<Transaction*>& history = optAccount.value()->getHistory();
+    if (!optAccount.has_value()) {
         return history;
     }
-    return std::vector<Transaction*>();
+
+    Account* account = optAccount.value();
+    std::vector<HistoryEntry> unsaved;
+    std::uint64_t head;
+    {
+        std::lock_guard<std::mutex> lock(account->getMutex());
+        unsaved = account->getHistory();
+        head = account->getHistoryHead();
+    }
+
+    // Saved entries are read on demand, outside the account lock
+    if (head != 0 && historyArchive != nullptr && !historyArchive->readChain(head, history)) {
+        LOG_WARN("Saved history of ", accountNo, " could not be read completely");
+    }
+    history.insert(history.end(), unsaved.begin(), unsaved.end());
+    return history;
 }
 
-// Apply interest to account
-bool BankSystem::applyInterest(const std::string& accountNo, const Timestamp& now) {
-    if (!validateAccountExists(accountNo)) {
-        return false;
+// One page of history, newest first
+HistoryPage BankSystem::historyPage(const std::string& accountNo, HistoryCursor cursor,
+                                    size_t limit) const {
+    HistoryPage page;
+    auto optAccount = accounts.getByAccountNo(accountNo);
+    if (!optAccount.has_value() || limit == 0) {
+        return page;
+    }
+
+    Account* account = optAccount.value();
+    std::uint64_t head;
+    std::uint64_t archived;
+    page.entries.reserve(limit);
+    {
+        std::lock_guard<std::mutex> lock(account->getMutex());
+        head = account->getHistoryHead();
+        archived = account->getArchivedHistoryCount();
+        std::uint64_t total = account->getHistoryCount();
+        if (cursor.position > total) {
+            cursor = HistoryCursor();
+            cursor.position = total;
+        }
+
+        // Unsaved entries sit above the archived ones
+        const std::vector<HistoryEntry>& unsaved = account->getHistory();
+        while (page.entries.size() < limit && cursor.position > archived) {
+            page.entries.push_back(unsaved[cursor.position - archived - 1]);
+            --cursor.position;
+        }
+    }
+
+    if (page.entries.size() < limit && cursor.position > 0) {
+        if (historyArchive == nullptr || head == 0) {
+            cursor.position = 0;
+        } else {
+            readArchivedPage(accountNo, head, archived, cursor, limit, page.entries);
+        }
+    }
+
+    page.next = cursor;
+    page.hasMore = !cursor.atOldest();
+    return page;
+}
+
+// Continue a page from the archive, one block at a time
+void BankSystem::readArchivedPage(const std::string& accountNo, std::uint64_t head,
+                                  std::uint64_t archived, HistoryCursor& cursor, size_t limit,
+                                  std::vector<HistoryEntry>& out) const {
+    // The hint is stale if the cursor predates the save that archived its entries
+    HistoryArchive::BlockInfo info;
+    if (cursor.block == 0 || cursor.blockEnd < cursor.position || cursor.blockEnd > archived) {
+        std::shared_ptr<const HistoryIndex> index = historyArchive->index(head);
+        cursor.block = 0;
+        if (index && index->getEntryCount() == archived) {
+            size_t found = index->findPosition(cursor.position - 1);
+            if (found < index->getBlocks().size()) {
+                const HistoryIndex::Block& block = index->getBlocks()[found];
+                cursor.block = block.offset;
+                cursor.blockEnd = block.firstPosition + block.count;
+            }
+        }
+    }
+
+    std::vector<HistoryEntry> block;
+    while (out.size() < limit && cursor.position > 0 && cursor.block != 0) {
+        block.clear();
+        if (!historyArchive->readBlock(cursor.block, block, &info) || info.count > cursor.blockEnd) {
+            break;
+        }
+
+        std::uint64_t blockStart = cursor.blockEnd - info.count;
+        if (cursor.position <= blockStart) {
+            break;
+        }
+        while (out.size() < limit && cursor.position > blockStart) {
+            out.push_back(block[cursor.position - blockStart - 1]);
+            --cursor.position;
+        }
+        if (cursor.position == blockStart) {
+            cursor.block = info.previous;
+            cursor.blockEnd = blockStart;
+        }
     }
 
+    if (out.size() < limit && cursor.position > 0) {
+        LOG_WARN("Saved history of ", accountNo, " could not be read completely");
+        cursor.position = 0;
+    }
+}
+
+// Entries posted in [from, to), oldest first
+std::vector<HistoryEntry> BankSystem::historyRange(const std::string& accountNo,
+                                                   const Timestamp& from,
+                                                   const Timestamp& to) const {
+    std::vector<HistoryEntry> result;
     auto optAccount = accounts.getByAccountNo(accountNo);
     if (!optAccount.has_value()) {
-        return false;
+        return result;
     }
 
+    std::int64_t fromMicros = HistoryEntry::toMicros(from);
+    std::int64_t toMicros = HistoryEntry::toMicros(to);
+    auto inRange = [&](const HistoryEntry& entry) {
+        return entry.timeMicros >= fromMicros && entry.timeMicros < toMicros;
+    };
+
     Account* account = optAccount.value();
-    return account->applyInterest(now);
+    std::vector<HistoryEntry> unsaved;
+    std::uint64_t head;
+    {
+        std::lock_guard<std::mutex> lock(account->getMutex());
+        for (const HistoryEntry& entry : account->getHistory()) {
+            if (inRange(entry)) {
+                unsaved.push_back(entry);
+            }
+        }
+        head = account->getHistoryHead();
+    }
+
+    if (head != 0 && historyArchive != nullptr) {
+        // Binary search the block list, then decode only overlapping blocks
+        std::shared_ptr<const HistoryIndex> index = historyArchive->index(head);
+        bool complete = index != nullptr;
+        size_t first = 0;
+        size_t last = 0;
+        if (index) {
+            index->findTimeRange(fromMicros, toMicros, first, last);
+        }
+
+        std::vector<HistoryEntry> block;
+        for (size_t i = first; i < last; ++i) {
+            const HistoryIndex::Block& info = index->getBlocks()[i];
+            if (info.maxTimeMicros < fromMicros || info.minTimeMicros >= toMicros) {
+                continue;
+            }
+            block.clear();
+            if (!historyArchive->readBlock(info.offset, block)) {
+                complete = false;
+                continue;
+            }
+            for (const HistoryEntry& entry : block) {
+                if (inRange(entry)) {
+                    result.push_back(entry);
+                }
+            }
+        }
+        if (!complete) {
+            LOG_WARN("Saved history of ", accountNo, " could not be read completely");
+        }
+    }
+
+    result.insert(result.end(), unsaved.begin(), unsaved.end());
+    return result;
+}
+
+// Apply interest to account
+bool BankSystem::applyInterest(const std::string& accountNo, const Timestamp& now) {
+    Account* account = resolveAccount(accountNo);
+    if (account == nullptr) {
+        return false;
+    }
+    std::uint64_t lsn = 0;
+    {
+        std::lock_guard<std::mutex> lock(account->getMutex());
+        Money before = account->getBalance();
+        if (!account->applyInterest(now)) {
+            return false;
+        }
+
+        if (journal != nullptr) {
+            TransactionJournal::Record record;
+            record.type = TransactionJournal::RecordType::Interest;
+            record.accountNo = accountNo;
+            record.amount = account->getBalance() - before;
+            record.balanceAfter = account->getBalance();
+            record.timeMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+                now.getTimePoint().time_since_epoch()).count();
+            record.transactionId = account->getLastHistoryId().getValue();
+            lsn = journal->append(record);
+        }
+        if (ledger != nullptr) {
+            ledger->refresh(*account);
+        }
+    }
+
+    if (journal != nullptr) {
+        journal->commit(lsn);
+    }
+    return true;
+}
+
+// Apply interest to all savings accounts
+InterestReport BankSystem::applyInterestToAll(const Timestamp& now) {
+    InterestEngine engine(accounts, ThreadPool::shared());
+    engine.setJournal(journal);
+    engine.setLedger(ledger);
+    return engine.applyAll(now);
+}
+
+// Book-wide figures
+BookSummary BankSystem::summarizeBook() const {
+    if (ledger != nullptr) {
+        return BankAnalytics::summarize(*ledger);
+    }
+    Ledger snapshot;
+    snapshot.loadFrom(accounts);
+    return BankAnalytics::summarize(snapshot);
 }
 
 // Check if account exists
@@ -236,12 +674,11 @@ void BankSystem::displayAccountSummary(const std::string& accountNo) const {
     std::cout << "Account Number: " << account->getAccountNo() << std::endl;
     std::cout << "Account Type: " << account->getAccountType() << std::endl;
     std::cout << "Owner ID: " << account->getOwnerId() << std::endl;
-    std::cout << "Balance: $" << std::fixed << std::setprecision(2)
-              << account->getBalance() << std::endl;
+    std::cout << "Balance: $" << account->getBalance() << std::endl;
 
     // Show overdraft if chequing account
-    double overdraft = accounts.getOverdraftLimit(accountNo);
-    if (overdraft > 0) {
+    Money overdraft = accounts.getOverdraftLimit(accountNo);
+    if (overdraft.isPositive()) {
         std::cout << "Overdraft Limit: $" << overdraft << std::endl;
         std::cout << "Available Funds: $" << (account->getBalance() + overdraft) << std::endl;
     }
@@ -269,8 +706,7 @@ void BankSystem::displayAllAccounts() const {
         std::cout << std::left << std::setw(15) << account->getAccountNo()
                   << std::setw(12) << account->getAccountType()
                   << std::setw(15) << account->getOwnerId()
-                  << std::right << std::setw(12) << std::fixed << std::setprecision(2)
-                  << "$" << account->getBalance() << std::endl;
+                  << std::right << std::setw(12) << "$" << account->getBalance() << std::endl;
     }
 
     std::cout << std::string(54, '-') << std::endl;
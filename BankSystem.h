@@ -6,8 +6,15 @@
 #include "AccountFactory.h"
 #include "AccountType.h"
 #include "Account.h"
+#include "BankAnalytics.h"
+#include "HistoryArchive.h"
+#include "HistoryEntry.h"
 #include "Transaction.h"
 #include "Timestamp.h"
+#include "TransactionJournal.h"
+#include "PostingInstruction.h"
+#include "InterestEngine.h"
+#include "Ledger.h"
 
 /**
  * BankSystem - Facade Pattern
@@ -19,32 +26,100 @@ private:
     AccountRepository& accounts;
     AccountFactory& factory;
 
+    // Optional write-ahead journal (nullptr when journaling is off)
+    TransactionJournal* journal;
+
+    // Saved transaction history (nullptr: only unsaved entries are visible)
+    HistoryArchive* historyArchive;
+
+    // Column mirror of the accounts kept current by every change made here
+    // (nullptr when nobody reads it)
+    Ledger* ledger;
+
+    // Unsaved entries an account may hold before they are moved to the archive
+    static const size_t HISTORY_SPILL_ENTRIES = 4 * HistoryArchive::BLOCK_ENTRIES;
+
+    // Wait until a transaction's journal record is durable
+    void commitToJournal(const Transaction& transaction);
+
     // Helper method to validate account existence
     bool validateAccountExists(const std::string& accountNo) const;
 
+    // Look up an account once, reporting an error if it does not exist
+    Account* resolveAccount(const std::string& accountNo);
+
+    // Move an account's unsaved history to the archive once it piles up
+    void spillHistory(Account* account);
+
+    // Copy an account's new state into the ledger, if one is attached
+    void refreshLedger(Account* account);
+
+    // Execute one validated postBatch instruction; lsn is its journal record
+    bool applyPosting(const PostingInstruction& instruction, Account* source, Account* target,
+                      const Timestamp& now, std::uint64_t& lsn);
+
+    // Fill the rest of a history page from the archive chain ending at head
+    void readArchivedPage(const std::string& accountNo, std::uint64_t head,
+                          std::uint64_t archived, HistoryCursor& cursor, size_t limit,
+                          std::vector<HistoryEntry>& out) const;
+
 public:
     // Constructor - takes references to repository and factory
     BankSystem(AccountRepository& accounts, AccountFactory& factory);
 
+    // Journal every posting before acknowledging it (nullptr disables)
+    void setJournal(TransactionJournal* journal);
+
+    // Read saved history from this archive (see DataPersistence::getHistoryArchive)
+    void setHistoryArchive(HistoryArchive* archive);
+
+    // Mirror the accounts into this empty ledger: it is filled now and kept
+    // current by every posting, interest credit, createAccount and
+    // deleteAccount made through this BankSystem (nullptr detaches).
+    // Attach after loading and journal replay, which bypass BankSystem
+    void setLedger(Ledger* ledger);
+
     // Account Management
     Account* createAccount(const std::string& ownerId, AccountType type,
-                          double initialBalance = 0.0, double overdraft = 0.0);
+                          Money initialBalance = Money(), Money overdraft = Money());
     bool deleteAccount(const std::string& accountNo);
 
     // Banking Operations
-    bool deposit(const std::string& accountNo, double amount);
-    bool withdraw(const std::string& accountNo, double amount);
+    bool deposit(const std::string& accountNo, Money amount);
+    bool withdraw(const std::string& accountNo, Money amount);
     bool transfer(const std::string& fromAccountNo, const std::string& toAccountNo,
-                 double amount);
+                 Money amount);
+
+    // Bulk posting: resolves every account number up front, applies the
+    // instructions in input order (so postings that depend on an earlier
+    // credit see it) and returns one result per instruction. Nothing is
+    // printed; the journal is committed once for the whole batch.
+    std::vector<PostingResult> postBatch(const PostingInstruction* instructions, size_t count);
+    std::vector<PostingResult> postBatch(const std::vector<PostingInstruction>& instructions);
 
     // Account Queries
-    double getBalance(const std::string& accountNo) const;
+    Money getBalance(const std::string& accountNo) const;
     std::vector<std::string> getAccountsByOwner(const std::string& ownerId) const;
-    std::vector<Transaction*> getTransactionHistory(const std::string& accountNo) const;
+    // Full history, oldest first; saved entries are read from the archive.
+    // Reads the whole chain - prefer historyPage/historyRange for display
+    std::vector<HistoryEntry> getTransactionHistory(const std::string& accountNo) const;
+
+    // Up to limit entries older than cursor, newest first. Cost is
+    // proportional to the page, not to the account's history
+    HistoryPage historyPage(const std::string& accountNo, HistoryCursor cursor = HistoryCursor(),
+                            size_t limit = 50) const;
+
+    // Entries posted in [from, to), oldest first. Saved blocks are found by
+    // binary search over the account's HistoryIndex
+    std::vector<HistoryEntry> historyRange(const std::string& accountNo, const Timestamp& from,
+                                           const Timestamp& to) const;
 
     // Interest Operations
     bool applyInterest(const std::string& accountNo, const Timestamp& now);
 
+    // Month-end accrual: apply interest to every savings account in parallel
+    InterestReport applyInterestToAll(const Timestamp& now);
+
     // Account Information
     bool accountExists(const std::string& accountNo) const;
     std::string getAccountType(const std::string& accountNo) const;
@@ -54,6 +129,10 @@ public:
     size_t getTotalAccountCount() const;
     std::vector<Account*> getAllAccounts() const;
 
+    // Book-wide figures (see BankAnalytics) from the attached ledger, or
+    // from a ledger filled from the accounts for this call if none is
+    BookSummary summarizeBook() const;
+
     // Display/Reporting
     void displayAccountSummary(const std::string& accountNo) const;
     void displayAllAccounts() const;
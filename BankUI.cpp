@@ -2,6 +2,7 @@
 #include <iostream>
 #include <iomanip>
 #include <limits>
+#include "Logger.h"
 #include "Timestamp.h"
 
 using namespace std;
@@ -70,11 +71,13 @@ void BankUI::displayLoginMenu() const {
 
 // Display success message
 void BankUI::displaySuccess(const string& message) const {
+    Logger::instance().flush();
     cout << "\nSUCCESS: " << message << endl;
 }
 
 // Display error message
 void BankUI::displayError(const string& message) const {
+    Logger::instance().flush();
     cout << "\nERROR: " << message << endl;
 }
 
@@ -100,23 +103,23 @@ int BankUI::getIntInput(const string& prompt) const {
     return value;
 }
 
-// Get double input with validation
-double BankUI::getDoubleInput(const string& prompt) const {
-    double value;
+// Get money input with validation (non-negative, at most two decimals)
+Money BankUI::getMoneyInput(const string& prompt) const {
+    Money value;
+    string line;
     cout << prompt;
 
-    while (!(cin >> value) || value < 0) {
-        cin.clear();
-        cin.ignore(numeric_limits<streamsize>::max(), '\n');
-        if (value < 0) {
+    while (getline(cin, line)) {
+        if (!Money::parse(line, value)) {
+            cout << "Invalid input. Please enter an amount (e.g. 25.50): ";
+        } else if (value.isNegative()) {
             cout << "Amount cannot be negative. Please try again: ";
         } else {
-            cout << "Invalid input. Please enter a number: ";
+            return value;
         }
     }
 
-    cin.ignore(numeric_limits<streamsize>::max(), '\n');
-    return value;
+    return Money();
 }
 
 // Get string input
@@ -144,14 +147,17 @@ AccountType BankUI::getAccountTypeInput() const {
     cout << "\nAccount Types:" << endl;
     cout << "  1. Savings Account (2% interest, no overdraft)" << endl;
     cout << "  2. Chequing Account ($500 overdraft, no interest)" << endl;
+    cout << "  3. TFSA (2% interest, no overdraft)" << endl;
 
-    int choice = getIntInput("\nSelect account type (1-2): ");
+    int choice = getIntInput("\nSelect account type (1-3): ");
 
     switch (choice) {
         case 1:
             return AccountType::Savings;
         case 2:
             return AccountType::Chequing;
+        case 3:
+            return AccountType::TFSA;
         default:
             cout << "Invalid choice. Defaulting to Savings." << endl;
             return AccountType::Savings;
@@ -168,6 +174,18 @@ bool BankUI::requireLogin() {
     return true;
 }
 
+// Helper: Re-authenticate the current session token
+bool BankUI::refreshSession() {
+    currentUser = auth.authenticate(sessionToken);
+    if (currentUser == nullptr) {
+        sessionToken.clear();
+        displayError("Your session has expired. Please log in again.");
+        pressEnterToContinue();
+        return false;
+    }
+    return true;
+}
+
 // Handler: Login
 void BankUI::handleLogin() {
     clearScreen();
@@ -176,10 +194,12 @@ void BankUI::handleLogin() {
     string userId = getStringInput("\nUser ID: ");
     string password = getPasswordInput("Password: ");
 
-    User* user = auth.login(userId, password);
+    string token = auth.startSession(userId, password);
+    User* user = token.empty() ? nullptr : auth.authenticate(token);
 
     if (user != nullptr) {
         currentUser = user;
+        sessionToken = token;
         displaySuccess("Login successful!");
         cout << "  Welcome, " << currentUser->getName() << "!" << endl;
     } else {
@@ -209,6 +229,13 @@ void BankUI::handleRegister() {
     }
 
     string name = getStringInput("Full Name: ");
+
+    if (name.empty()) {
+        displayError("Name cannot be empty.");
+        pressEnterToContinue();
+        return;
+    }
+
     string email = getStringInput("Email (optional): ");
     string password = getPasswordInput("Password (min 4 characters): ");
     string confirmPassword = getPasswordInput("Confirm Password: ");
@@ -219,6 +246,12 @@ void BankUI::handleRegister() {
         return;
     }
 
+    if (password.length() < 4) {
+        displayError("Password must be at least 4 characters.");
+        pressEnterToContinue();
+        return;
+    }
+
     if (auth.registerUser(userId, name, email, password)) {
         displaySuccess("Registration successful!");
         cout << "  You can now login with User ID: " << userId << endl;
@@ -233,6 +266,8 @@ void BankUI::handleRegister() {
 void BankUI::handleLogout() {
     if (currentUser != nullptr) {
         string userName = currentUser->getName();
+        auth.endSession(sessionToken);
+        sessionToken.clear();
         currentUser = nullptr;
 
         clearScreen();
@@ -267,7 +302,14 @@ void BankUI::handleChangePassword() {
         return;
     }
 
-    if (auth.changePassword(userId, oldPassword, newPassword)) {
+    if (newPassword.length() < 4) {
+        displayError("New password must be at least 4 characters.");
+        pressEnterToContinue();
+        return;
+    }
+
+    // The change revokes every session of the user, this one included
+    if (auth.changePassword(userId, oldPassword, newPassword, &sessionToken)) {
         displaySuccess("Password changed successfully!");
     } else {
         displayError("Failed to change password. Please check your current password.");
@@ -292,7 +334,7 @@ void BankUI::handleCreateAccount() {
          << " (" << ownerId << ")" << endl;
 
     AccountType type = getAccountTypeInput();
-    double initialBalance = getDoubleInput("\nEnter initial deposit amount: $");
+    Money initialBalance = getMoneyInput("\nEnter initial deposit amount: $");
 
     Account* account = bank.createAccount(ownerId, type, initialBalance);
 
@@ -300,8 +342,7 @@ void BankUI::handleCreateAccount() {
         displaySuccess("Account created successfully!");
         cout << "\n  Account Number: " << account->getAccountNo() << endl;
         cout << "  Account Type: " << account->getAccountType() << endl;
-        cout << "  Initial Balance: $" << fixed << setprecision(2)
-             << account->getBalance() << endl;
+        cout << "  Initial Balance: $" << account->getBalance() << endl;
     } else {
         displayError("Failed to create account. Please try again.");
     }
@@ -322,12 +363,11 @@ void BankUI::handleDeposit() {
         return;
     }
 
-    cout << "\nCurrent balance: $" << fixed << setprecision(2)
-         << bank.getBalance(accountNo) << endl;
+    cout << "\nCurrent balance: $" << bank.getBalance(accountNo) << endl;
 
-    double amount = getDoubleInput("\nEnter deposit amount: $");
+    Money amount = getMoneyInput("\nEnter deposit amount: $");
 
-    if (amount <= 0) {
+    if (!amount.isPositive()) {
         displayError("Deposit amount must be greater than zero.");
         pressEnterToContinue();
         return;
@@ -335,8 +375,7 @@ void BankUI::handleDeposit() {
 
     if (bank.deposit(accountNo, amount)) {
         displaySuccess("Deposit completed successfully!");
-        cout << "  New balance: $" << fixed << setprecision(2)
-             << bank.getBalance(accountNo) << endl;
+        cout << "  New balance: $" << bank.getBalance(accountNo) << endl;
     } else {
         displayError("Deposit failed. Please try again.");
     }
@@ -357,12 +396,11 @@ void BankUI::handleWithdraw() {
         return;
     }
 
-    cout << "\nCurrent balance: $" << fixed << setprecision(2)
-         << bank.getBalance(accountNo) << endl;
+    cout << "\nCurrent balance: $" << bank.getBalance(accountNo) << endl;
 
-    double amount = getDoubleInput("\nEnter withdrawal amount: $");
+    Money amount = getMoneyInput("\nEnter withdrawal amount: $");
 
-    if (amount <= 0) {
+    if (!amount.isPositive()) {
         displayError("Withdrawal amount must be greater than zero.");
         pressEnterToContinue();
         return;
@@ -370,8 +408,7 @@ void BankUI::handleWithdraw() {
 
     if (bank.withdraw(accountNo, amount)) {
         displaySuccess("Withdrawal completed successfully!");
-        cout << "  New balance: $" << fixed << setprecision(2)
-             << bank.getBalance(accountNo) << endl;
+        cout << "  New balance: $" << bank.getBalance(accountNo) << endl;
     } else {
         displayError("Withdrawal failed. Insufficient funds or invalid amount.");
     }
@@ -392,8 +429,7 @@ void BankUI::handleTransfer() {
         return;
     }
 
-    cout << "\nSource account balance: $" << fixed << setprecision(2)
-         << bank.getBalance(fromAccount) << endl;
+    cout << "\nSource account balance: $" << bank.getBalance(fromAccount) << endl;
 
     string toAccount = getStringInput("\nTo account number: ");
 
@@ -409,9 +445,9 @@ void BankUI::handleTransfer() {
         return;
     }
 
-    double amount = getDoubleInput("\nEnter transfer amount: $");
+    Money amount = getMoneyInput("\nEnter transfer amount: $");
 
-    if (amount <= 0) {
+    if (!amount.isPositive()) {
         displayError("Transfer amount must be greater than zero.");
         pressEnterToContinue();
         return;
@@ -419,10 +455,8 @@ void BankUI::handleTransfer() {
 
     if (bank.transfer(fromAccount, toAccount, amount)) {
         displaySuccess("Transfer completed successfully!");
-        cout << "  " << fromAccount << " balance: $" << fixed << setprecision(2)
-             << bank.getBalance(fromAccount) << endl;
-        cout << "  " << toAccount << " balance: $" << fixed << setprecision(2)
-             << bank.getBalance(toAccount) << endl;
+        cout << "  " << fromAccount << " balance: $" << bank.getBalance(fromAccount) << endl;
+        cout << "  " << toAccount << " balance: $" << bank.getBalance(toAccount) << endl;
     } else {
         displayError("Transfer failed. Please check account balances.");
     }
@@ -443,13 +477,13 @@ void BankUI::handleCheckBalance() {
         return;
     }
 
-    double balance = bank.getBalance(accountNo);
+    Money balance = bank.getBalance(accountNo);
 
     cout << "\n";
     cout << "  Account: " << accountNo << endl;
     cout << "  Type: " << bank.getAccountType(accountNo) << endl;
     cout << "  Owner: " << bank.getOwnerId(accountNo) << endl;
-    cout << "  Balance: $" << fixed << setprecision(2) << balance << endl;
+    cout << "  Balance: $" << balance << endl;
 
     pressEnterToContinue();
 }
@@ -478,8 +512,7 @@ void BankUI::handleViewMyAccounts() {
         for (const auto& accountNo : accounts) {
             cout << "\n  Account: " << accountNo << endl;
             cout << "    Type: " << bank.getAccountType(accountNo) << endl;
-            cout << "    Balance: $" << fixed << setprecision(2)
-                 << bank.getBalance(accountNo) << endl;
+            cout << "    Balance: $" << bank.getBalance(accountNo) << endl;
         }
 
         cout << string(60, '-') << endl;
@@ -532,11 +565,17 @@ void BankUI::handleDeleteAccount() {
     }
 
     // Show account details
+    Money balance = bank.getBalance(accountNo);
     cout << "\nAccount to delete:" << endl;
     cout << "  Account: " << accountNo << endl;
     cout << "  Type: " << bank.getAccountType(accountNo) << endl;
-    cout << "  Balance: $" << fixed << setprecision(2)
-         << bank.getBalance(accountNo) << endl;
+    cout << "  Balance: $" << balance << endl;
+
+    if (!balance.isZero()) {
+        displayError("Cannot delete account with non-zero balance. Please withdraw all funds first.");
+        pressEnterToContinue();
+        return;
+    }
 
     string confirm = getStringInput("\nAre you sure you want to delete this account? (yes/no): ");
 
@@ -568,20 +607,20 @@ void BankUI::handleApplyInterest() {
 
     string accountType = bank.getAccountType(accountNo);
 
-    if (accountType != "Savings") {
-        displayError("Interest can only be applied to Savings accounts.");
+    if (accountType != "Savings" && accountType != "TFSA") {
+        displayError("Interest can only be applied to Savings and TFSA accounts.");
         pressEnterToContinue();
         return;
     }
 
-    double oldBalance = bank.getBalance(accountNo);
+    Money oldBalance = bank.getBalance(accountNo);
 
     if (bank.applyInterest(accountNo, Timestamp::now())) {
-        double newBalance = bank.getBalance(accountNo);
-        double interest = newBalance - oldBalance;
+        Money newBalance = bank.getBalance(accountNo);
+        Money interest = newBalance - oldBalance;
 
         displaySuccess("Interest applied successfully!");
-        cout << "  Interest earned: $" << fixed << setprecision(2) << interest << endl;
+        cout << "  Interest earned: $" << interest << endl;
         cout << "  New balance: $" << newBalance << endl;
     } else {
         cout << "\nNo interest applied (account updated recently or no balance)." << endl;
@@ -644,6 +683,10 @@ void BankUI::run() {
 
         int choice = getIntInput("Enter your choice (0-12): ");
 
+        if (choice != 0 && !refreshSession()) {
+            break;
+        }
+
         switch (choice) {
             case 1:
                 handleCreateAccount();
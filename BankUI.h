@@ -4,6 +4,7 @@
 #include <string>
 #include "BankSystem.h"
 #include "AccountType.h"
+#include "Money.h"
 #include "AuthService.h"
 #include "User.h"
 
@@ -17,6 +18,7 @@ private:
     BankSystem& bank;
     AuthService& auth;
     User* currentUser;  // Currently logged-in user (nullptr if not logged in)
+    std::string sessionToken;  // Session of currentUser
     bool running;
 
     // Display functions
@@ -30,7 +32,7 @@ private:
 
     // Input helpers
     int getIntInput(const std::string& prompt) const;
-    double getDoubleInput(const std::string& prompt) const;
+    Money getMoneyInput(const std::string& prompt) const;
     std::string getStringInput(const std::string& prompt) const;
     std::string getPasswordInput(const std::string& prompt) const;
     AccountType getAccountTypeInput() const;
@@ -57,6 +59,9 @@ private:
     // Helper to check if user is logged in
     bool requireLogin();
 
+    // Re-check the session; logs the user out if it has expired
+    bool refreshSession();
+
 public:
     // Constructor
     BankUI(BankSystem& bank, AuthService& auth);
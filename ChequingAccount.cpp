@@ -1,49 +1,50 @@
 #include "ChequingAccount.h"
-#include <iostream>
+#include "Logger.h"
 
 // Constructor
 ChequingAccount::ChequingAccount(const std::string& accountNo, const std::string& ownerId,
-                                 double balance, double overdraftLimit)
+                                 Money balance, Money overdraftLimit)
     : Account(accountNo, ownerId, balance), overdraftLimit(overdraftLimit) {
 
-    if (overdraftLimit < 0) {
+    if (overdraftLimit.isNegative()) {
         throw std::invalid_argument("Overdraft limit cannot be negative");
     }
 }
 
 // Get overdraft limit
-double ChequingAccount::getOverdraftLimit() const {
+Money ChequingAccount::getOverdraftLimit() const {
     return overdraftLimit;
 }
 
 // Set overdraft limit
-void ChequingAccount::setOverdraftLimit(double limit) {
-    if (limit < 0) {
+void ChequingAccount::setOverdraftLimit(Money limit) {
+    if (limit.isNegative()) {
         throw std::invalid_argument("Overdraft limit cannot be negative");
     }
     overdraftLimit = limit;
+    markDirty();
 }
 
 // Override withdraw to support overdraft
-bool ChequingAccount::withdraw(double amount) {
-    if (amount <= 0) {
-        std::cerr << "Withdrawal amount must be positive" << std::endl;
+bool ChequingAccount::withdraw(Money amount) {
+    if (!amount.isPositive()) {
+        LOG_DEBUG("Withdrawal amount must be positive");
         return false;
     }
 
     // Check if withdrawal exceeds balance + overdraft limit
     if (amount > balance + overdraftLimit) {
-        std::cerr << "Insufficient funds. Exceeds overdraft limit." << std::endl;
-        std::cerr << "Available: $" << balance << " + $" << overdraftLimit
-                  << " overdraft = $" << (balance + overdraftLimit) << std::endl;
+        LOG_DEBUG("Insufficient funds. Exceeds overdraft limit. Available: $", balance,
+                  " + $", overdraftLimit, " overdraft = $", (balance + overdraftLimit));
         return false;
     }
 
     balance -= amount;
+    markDirty();
 
     // Warn if account is now overdrawn
-    if (balance < 0) {
-        std::cout << "WARNING: Account overdrawn by $" << (-balance) << std::endl;
+    if (balance.isNegative()) {
+        LOG_INFO("Account ", getAccountNo(), " overdrawn by $", (-balance));
     }
 
     return true;
@@ -54,6 +55,7 @@ bool ChequingAccount::applyInterest(const Timestamp& now) {
 
     // For now just update the timestamp without applying interest
     lastInterestApplied = now;
+    markDirty();
 
     // If adding minimal interest:
     // double days = now.daysSince(lastInterestApplied);
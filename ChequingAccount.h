@@ -1,20 +1,21 @@
 #pragma once
 #include "Account.h"
+#include "ObjectPool.h"
 
-class ChequingAccount : public Account {
+class ChequingAccount : public Account, public PoolAllocated<ChequingAccount> {
 private:
-    double overdraftLimit;
+    Money overdraftLimit;
 
 public:
     // constructor
-    ChequingAccount(const std::string& accountNo, const std::string& ownerId, double balance, double overdraftLimit);
+    ChequingAccount(const std::string& accountNo, const std::string& ownerId, Money balance, Money overdraftLimit);
 
     //overdraft logic
-    double getOverdraftLimit() const;
-    void setOverdraftLimit(double limit);
+    Money getOverdraftLimit() const;
+    void setOverdraftLimit(Money limit);
 
     //override withdraw to allow overdraft
-    bool withdraw(double amount) override;
+    bool withdraw(Money amount) override;
 
 
     bool applyInterest(const Timestamp& now) override;
@@ -1,15 +1,327 @@
 #include "DataPersistence.h"
 #include "SavingsAccount.h"
 #include "ChequingAccount.h"
+#include "TFSAAccount.h"
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <fcntl.h>
+#include <unistd.h>
+
+// ACCOUNTS_V3 binary snapshot layout (native byte order):
+//   SnapshotHeader | SnapshotRecord[recordCount] | string table
+// Account numbers and owner IDs live in the string table and records refer
+// to them by offset/length, so loading needs no per-field parsing.
+static const char SNAPSHOT_MAGIC[12] = {'A', 'C', 'C', 'O', 'U', 'N', 'T', 'S', '_', 'V', '3', '\n'};
+
+struct SnapshotHeader {
+    char magic[12];                 // "ACCOUNTS_V3\n" - reads as a header line
+    std::uint32_t recordSize;       // sizeof(SnapshotRecord) when written
+    std::uint64_t recordCount;
+    std::uint64_t stringTableSize;
+    std::uint64_t checksum;         // Over the records and string table
+};
+
+struct SnapshotRecord {
+    std::uint64_t accountNoOffset;
+    std::uint64_t ownerIdOffset;
+    std::uint32_t accountNoLength;
+    std::uint32_t ownerIdLength;
+    std::uint8_t accountType;       // AccountType, or DELTA_REMOVED in a delta
+    std::uint8_t reserved[3];
+    std::uint32_t historyCount;     // Entries in the saved history chain
+    std::int64_t balanceCents;
+    std::int64_t overdraftCents;    // Chequing only
+    double interestRate;            // Savings only
+    std::int64_t lastInterestMicros;  // Last interest accrual (0 = unknown)
+    std::uint64_t historyHead;      // Newest history block in the archive (0 = none)
+    std::uint64_t lastHistoryId;    // Newest history entry id
+};
+
+// Accounts delta file: a sequence of batches, one per checkpoint
+//   DeltaHeader | SnapshotRecord[recordCount] | string table
+static const char DELTA_MAGIC[12] = {'A', 'C', 'C', 'D', 'E', 'L', 'T', 'A', '_', 'V', '2', '\n'};
+
+struct DeltaHeader {
+    char magic[12];                 // "ACCDELTA_V2\n"
+    std::uint32_t recordSize;       // sizeof(SnapshotRecord) when written
+    std::uint64_t recordCount;
+    std::uint64_t stringTableSize;
+    std::uint64_t checksum;         // Over the records and string table
+    std::uint64_t baseChecksum;     // Checksum of the snapshot this batch extends
+};
+
+// accountType of a delta record that removes the account
+static const std::uint8_t DELTA_REMOVED = 0xFF;
+
+// Users delta file: "USERS_DELTA_V1 <base checksum>" then one line per change
+//   +|UserID|Name|Email|PasswordHash   (added or changed)
+//   -|UserID                           (removed)
+static const char USERS_DELTA_HEADER[] = "USERS_DELTA_V1";
+
+static const std::uint64_t FNV64_OFFSET = 14695981039346656037ull;
+
+// FNV-1a over 64-bit words (byte-wise for the tail), chained through seed
+static std::uint64_t snapshotChecksum(const char* data, std::size_t size, std::uint64_t seed) {
+    const std::uint64_t prime = 1099511628211ull;
+    std::uint64_t hash = seed;
+    std::size_t i = 0;
+
+    for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * prime;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * prime;
+    }
+    return hash;
+}
+
+// Size of a file in bytes (0 if it does not exist)
+static std::uint64_t fileSize(const std::string& path) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) {
+        return 0;
+    }
+    return static_cast<std::uint64_t>(info.st_size);
+}
+
+// Append data to a file and fsync it
+static bool appendDurably(const std::string& path, const std::string& data) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    bool ok = fd >= 0 &&
+              ::write(fd, data.data(), data.size()) == static_cast<ssize_t>(data.size()) &&
+              ::fsync(fd) == 0;
+    if (fd >= 0) {
+        ok = (::close(fd) == 0) && ok;
+    }
+    return ok;
+}
+
+// Replace a file through an fsynced temporary, so a crash leaves either
+// the old contents or the new ones
+static bool replaceDurably(const std::string& path, const std::string& data) {
+    std::string tempFile = path + ".tmp";
+    FILE* file = std::fopen(tempFile.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    bool ok = std::fwrite(data.data(), 1, data.size(), file) == data.size() &&
+              std::fflush(file) == 0 &&
+              ::fsync(fileno(file)) == 0;
+    ok = (std::fclose(file) == 0) && ok;
+
+    if (!ok || std::rename(tempFile.c_str(), path.c_str()) != 0) {
+        std::remove(tempFile.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Read a whole file; false if it cannot be opened
+static bool readFile(const std::string& path, std::string& contents) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    contents = buffer.str();
+    return true;
+}
+
+// Copy a record out of a mapped file (records need not be aligned there)
+static SnapshotRecord decodeRecord(const char* data) {
+    SnapshotRecord record;
+    std::memcpy(&record, data, sizeof(record));
+    return record;
+}
+
+// Snapshot records plus their string table, built by saves and checkpoints
+struct RecordBatch {
+    // History handed to the archive for one account, applied once saved
+    struct ArchivedHistory {
+        Account* account;
+        std::uint64_t previous;     // Head the entries were staged after
+        std::uint64_t head;
+        size_t count;
+    };
+
+    std::vector<SnapshotRecord> records;
+    std::string strings;
+    // Owners usually hold several accounts; store each owner ID once
+    std::unordered_map<std::string, std::uint64_t> ownerOffsets;
+    std::vector<ArchivedHistory> archived;
+    std::uint64_t historyGeneration = 0;
+    bool historyFailed = false;
+
+    // Record an account's current state, stage its unsaved history in the
+    // archive and clear its dirty flag
+    void add(Account* account, HistoryArchive& archive) {
+        SnapshotRecord record = {};
+        {
+            std::lock_guard<std::mutex> lock(account->getMutex());
+            record.balanceCents = account->getBalance().getCents();
+            if (auto* savings = dynamic_cast<SavingsAccount*>(account)) {
+                AccountType type = dynamic_cast<TFSAAccount*>(account) != nullptr
+                                       ? AccountType::TFSA : AccountType::Savings;
+                record.accountType = static_cast<std::uint8_t>(type);
+                record.interestRate = savings->getInterestRate();
+            } else if (auto* chequing = dynamic_cast<ChequingAccount*>(account)) {
+                record.accountType = static_cast<std::uint8_t>(AccountType::Chequing);
+                record.overdraftCents = chequing->getOverdraftLimit().getCents();
+            } else {
+                std::cerr << "Skipping account of unsupported type: "
+                          << account->getAccountNo() << std::endl;
+                return;
+            }
+            record.lastInterestMicros = HistoryEntry::toMicros(account->getLastInterestApplied());
+            record.historyHead = account->getHistoryHead();
+            record.historyCount = account->getArchivedHistoryCount();
+            record.lastHistoryId = account->getLastHistoryId().getValue();
+
+            const std::vector<HistoryEntry>& unsaved = account->getHistory();
+            if (!unsaved.empty()) {
+                if (archived.empty()) {
+                    historyGeneration = archive.getGeneration();
+                }
+                std::uint64_t head = archive.stage(record.historyHead, unsaved.data(), unsaved.size());
+                if (head == 0) {
+                    historyFailed = true;
+                    return;
+                }
+                archived.push_back({account, record.historyHead, head, unsaved.size()});
+                record.historyHead = head;
+                record.historyCount += static_cast<std::uint32_t>(unsaved.size());
+            }
+            account->clearDirty();
+        }
+
+        const std::string& accountNo = account->getAccountNo();
+        const std::string& ownerId = account->getOwnerId();
+
+        record.accountNoOffset = strings.size();
+        record.accountNoLength = static_cast<std::uint32_t>(accountNo.size());
+        strings += accountNo;
+
+        auto owner = ownerOffsets.find(ownerId);
+        if (owner == ownerOffsets.end()) {
+            owner = ownerOffsets.emplace(ownerId, strings.size()).first;
+            strings += ownerId;
+        }
+        record.ownerIdOffset = owner->second;
+        record.ownerIdLength = static_cast<std::uint32_t>(ownerId.size());
+        records.push_back(record);
+    }
+
+    // Record the removal of an account (deltas only)
+    void addRemoval(const std::string& accountNo) {
+        SnapshotRecord record = {};
+        record.accountType = DELTA_REMOVED;
+        record.accountNoOffset = strings.size();
+        record.accountNoLength = static_cast<std::uint32_t>(accountNo.size());
+        record.ownerIdOffset = strings.size();
+        strings += accountNo;
+        records.push_back(record);
+    }
+
+    // Write the staged history; false if any of it was lost
+    bool commitHistory(HistoryArchive& archive) {
+        if (historyFailed || !archive.commit()) {
+            return false;
+        }
+        return archived.empty() || archive.getGeneration() == historyGeneration;
+    }
+
+    // Drop the saved entries from memory once the records are on disk.
+    // A spill may have archived them in the meantime (the account lock is
+    // not held across the save); the account then already points past them
+    void finishHistory() {
+        for (const ArchivedHistory& entry : archived) {
+            std::lock_guard<std::mutex> lock(entry.account->getMutex());
+            entry.account->markHistoryArchived(entry.previous, entry.head, entry.count);
+        }
+    }
+
+    std::size_t recordBytes() const {
+        return records.size() * sizeof(SnapshotRecord);
+    }
+
+    std::uint64_t checksum() const {
+        std::uint64_t sum = snapshotChecksum(reinterpret_cast<const char*>(records.data()),
+                                             recordBytes(), FNV64_OFFSET);
+        return snapshotChecksum(strings.data(), strings.size(), sum);
+    }
+};
+
+// Resolve a record's strings; false if they point outside the string table
+static bool recordStrings(const SnapshotRecord& record, const char* strings,
+                          std::uint64_t stringTableSize,
+                          std::string& accountNo, std::string& ownerId) {
+    if (record.accountNoOffset > stringTableSize ||
+        record.accountNoLength > stringTableSize - record.accountNoOffset ||
+        record.ownerIdOffset > stringTableSize ||
+        record.ownerIdLength > stringTableSize - record.ownerIdOffset) {
+        std::cerr << "Skipping account record with invalid string reference" << std::endl;
+        return false;
+    }
+    accountNo.assign(strings + record.accountNoOffset, record.accountNoLength);
+    ownerId.assign(strings + record.ownerIdOffset, record.ownerIdLength);
+    return true;
+}
+
+// Rebuild an account from a record (nullptr for unsupported account types)
+static Account* accountFromRecord(AccountFactory& factory, const SnapshotRecord& record,
+                                  const std::string& accountNo, const std::string& ownerId) {
+    Account* account = factory.restore(static_cast<AccountType>(record.accountType),
+                                       accountNo, ownerId,
+                                       Money::fromCents(record.balanceCents),
+                                       Money::fromCents(record.overdraftCents),
+                                       record.interestRate);
+    if (account == nullptr) {
+        std::cerr << "Skipping account of unsupported type: " << accountNo << std::endl;
+        return nullptr;
+    }
+
+    if (record.lastInterestMicros != 0) {
+        account->restoreLastInterestApplied(Timestamp(std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::microseconds(record.lastInterestMicros)))));
+    }
+    account->restoreHistory(record.historyHead, record.historyCount,
+                            TransactionId(record.lastHistoryId));
+    return account;
+}
 
 // Constructor
 DataPersistence::DataPersistence(const std::string& accountsFile,
                                  const std::string& usersFile)
-    : accountsFile(accountsFile), usersFile(usersFile) {
+    : accountsFile(accountsFile), usersFile(usersFile),
+      historyArchive(accountsFile + ".history"),
+      accountsBase(0), accountsBaseKnown(false),
+      usersBase(0), usersBaseKnown(false) {
+}
+
+std::string DataPersistence::accountsDeltaFile() const {
+    return accountsFile + ".delta";
+}
+
+std::string DataPersistence::usersDeltaFile() const {
+    return usersFile + ".delta";
+}
+
+HistoryArchive& DataPersistence::getHistoryArchive() {
+    return historyArchive;
 }
 
 // Helper: Escape string for storage
@@ -30,77 +342,218 @@ std::string DataPersistence::unescapeString(const std::string& str) {
     return str;  // Simple version - no unescaping needed
 }
 
-// Save accounts to file
-bool DataPersistence::saveAccounts(const AccountRepository& repository) {
-    std::ofstream file(accountsFile);
+// Save accounts to file (ACCOUNTS_V3 binary snapshot)
+bool DataPersistence::saveAccounts(AccountRepository& repository) {
+    std::vector<Account*> accounts = repository.getAllAccounts();
 
-    if (!file.is_open()) {
+    // Every account is in the new snapshot, so pending changes are covered
+    RecordBatch batch;
+    batch.records.reserve(accounts.size());
+    repository.takeRemovedAccountNos();
+    for (Account* account : accounts) {
+        batch.add(account, historyArchive);
+    }
+
+    // History first: the snapshot refers to the new blocks
+    if (!batch.commitHistory(historyArchive)) {
+        std::cerr << "Failed to save transaction history: " << historyArchive.getPath() << std::endl;
+        accountsBaseKnown = false;
+        return false;
+    }
+
+    std::size_t recordBytes = batch.recordBytes();
+
+    SnapshotHeader header = {};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.recordSize = sizeof(SnapshotRecord);
+    header.recordCount = batch.records.size();
+    header.stringTableSize = batch.strings.size();
+    header.checksum = batch.checksum();
+
+    // Write a temporary file and rename it over the old snapshot, so a crash
+    // mid-save never leaves a truncated snapshot next to a reset journal
+    std::string tempFile = accountsFile + ".tmp";
+    FILE* file = std::fopen(tempFile.c_str(), "wb");
+
+    if (file == nullptr) {
         std::cerr << "Failed to open accounts file for writing: "
                   << accountsFile << std::endl;
+        accountsBaseKnown = false;
         return false;
     }
 
-    std::vector<Account*> accounts = repository.getAllAccounts();
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(batch.records.data(), 1, recordBytes, file) == recordBytes &&
+              std::fwrite(batch.strings.data(), 1, batch.strings.size(), file) == batch.strings.size() &&
+              std::fflush(file) == 0 &&
+              ::fsync(fileno(file)) == 0;
+    ok = (std::fclose(file) == 0) && ok;
+
+    if (!ok || std::rename(tempFile.c_str(), accountsFile.c_str()) != 0) {
+        std::cerr << "Failed to write accounts file: " << accountsFile << std::endl;
+        std::remove(tempFile.c_str());
+        // Dirty flags were cleared; the next checkpoint must be a full save
+        accountsBaseKnown = false;
+        return false;
+    }
 
-    // Write header
-    file << "ACCOUNTS_V1" << std::endl;
-    file << accounts.size() << std::endl;
+    // The old delta extends the previous snapshot (its base no longer matches)
+    std::remove(accountsDeltaFile().c_str());
+    batch.finishHistory();
+    accountsBase = header.checksum;
+    accountsBaseKnown = true;
 
-    // Write each account
-    for (Account* account : accounts) {
-        // Format: AccountType|AccountNo|OwnerID|Balance
-        file << account->getAccountType() << "|"
-             << escapeString(account->getAccountNo()) << "|"
-             << escapeString(account->getOwnerId()) << "|"
-             << account->getBalance() << std::endl;
+    std::cout << "Saved " << batch.records.size() << " accounts to " << accountsFile << std::endl;
+    return true;
+}
+
+// Save users to file
+bool DataPersistence::saveUsers(UserRepository& repository) {
+    // Format: UserID|Name|Email|PasswordHash, after a header and count
+    std::ostringstream content;
+    content << "USERS_V1" << "\n";
+    content << repository.getUserCount() << "\n";
+    repository.forEachUser([&content](const User& user) {
+        content << escapeString(user.getUserId()) << "|"
+                << escapeString(user.getName()) << "|"
+                << escapeString(user.getEmail()) << "|"
+                << escapeString(user.getPasswordHash()) << "\n";
+    });
+    std::string text = content.str();
+
+    // Same temporary-and-rename path as the accounts snapshot
+    if (!replaceDurably(usersFile, text)) {
+        std::cerr << "Failed to write users file: " << usersFile << std::endl;
+        usersBaseKnown = false;
+        return false;
     }
 
-    file.close();
-    std::cout << "Saved " << accounts.size() << " accounts to " << accountsFile << std::endl;
+    std::remove(usersDeltaFile().c_str());
+    repository.markClean();
+    usersBase = snapshotChecksum(text.data(), text.size(), FNV64_OFFSET);
+    usersBaseKnown = true;
+
+    std::cout << "Saved " << repository.getUserCount() << " users to " << usersFile << std::endl;
     return true;
 }
 
-// Save users to file
-bool DataPersistence::saveUsers(const UserRepository& repository) {
-    std::ofstream file(usersFile);
+// Save all data
+bool DataPersistence::saveAll(AccountRepository& accountRepo,
+                              UserRepository& userRepo) {
+    bool accountsOk = saveAccounts(accountRepo);
+    bool usersOk = saveUsers(userRepo);
+    return accountsOk && usersOk;
+}
 
-    if (!file.is_open()) {
-        std::cerr << "Failed to open users file for writing: "
-                  << usersFile << std::endl;
+// Append changed accounts to the delta file
+bool DataPersistence::checkpointAccounts(AccountRepository& repository) {
+    if (!accountsBaseKnown || fileSize(accountsDeltaFile()) * 2 > fileSize(accountsFile)) {
+        return saveAccounts(repository);
+    }
+
+    // Removals first, so an account removed and recreated ends up present
+    RecordBatch batch;
+    for (const std::string& accountNo : repository.takeRemovedAccountNos()) {
+        if (!repository.existsAccountNo(accountNo)) {
+            batch.addRemoval(accountNo);
+        }
+    }
+    for (Account* account : repository.getDirtyAccounts()) {
+        batch.add(account, historyArchive);
+    }
+    if (batch.records.empty()) {
+        return true;
+    }
+
+    if (!batch.commitHistory(historyArchive)) {
+        std::cerr << "Failed to save transaction history: " << historyArchive.getPath() << std::endl;
+        accountsBaseKnown = false;
+        return false;
+    }
+
+    DeltaHeader header = {};
+    std::memcpy(header.magic, DELTA_MAGIC, sizeof(header.magic));
+    header.recordSize = sizeof(SnapshotRecord);
+    header.recordCount = batch.records.size();
+    header.stringTableSize = batch.strings.size();
+    header.checksum = batch.checksum();
+    header.baseChecksum = accountsBase;
+
+    // One write per batch; a torn batch fails its checksum and is cut off on load
+    std::string buffer(reinterpret_cast<const char*>(&header), sizeof(header));
+    buffer.append(reinterpret_cast<const char*>(batch.records.data()), batch.recordBytes());
+    buffer += batch.strings;
+
+    std::string deltaFile = accountsDeltaFile();
+    if (!appendDurably(deltaFile, buffer)) {
+        std::cerr << "Failed to write accounts delta: " << deltaFile << std::endl;
+        // Dirty flags were cleared; the next checkpoint must be a full save
+        accountsBaseKnown = false;
         return false;
     }
 
-    std::vector<User> users = repository.getAllUsers();
+    batch.finishHistory();
+    std::cout << "Saved " << batch.records.size() << " changed accounts to "
+              << deltaFile << std::endl;
+    return true;
+}
 
-    // Write header
-    file << "USERS_V1" << std::endl;
-    file << users.size() << std::endl;
+// Append changed users to the delta file
+bool DataPersistence::checkpointUsers(UserRepository& repository) {
+    std::string deltaFile = usersDeltaFile();
+    std::uint64_t deltaSize = fileSize(deltaFile);
+    if (!usersBaseKnown || deltaSize * 2 > fileSize(usersFile)) {
+        return saveUsers(repository);
+    }
 
-    // Write each user
-    for (const User& user : users) {
-        // Format: UserID|Name|Email|PasswordHash
-        file << escapeString(user.getUserId()) << "|"
-             << escapeString(user.getName()) << "|"
-             << escapeString(user.getEmail()) << "|"
-             << escapeString(user.getPasswordHash()) << std::endl;
+    std::ostringstream content;
+    if (deltaSize == 0) {
+        content << USERS_DELTA_HEADER << " " << usersBase << "\n";
     }
 
-    file.close();
-    std::cout << "Saved " << users.size() << " users to " << usersFile << std::endl;
+    size_t changes = 0;
+    for (const std::string& userId : repository.takeRemovedUserIds()) {
+        if (!repository.existsUserId(userId)) {
+            content << "-|" << escapeString(userId) << "\n";
+            ++changes;
+        }
+    }
+    for (User* user : repository.getDirtyUsers()) {
+        content << "+|" << escapeString(user->getUserId()) << "|"
+                << escapeString(user->getName()) << "|"
+                << escapeString(user->getEmail()) << "|"
+                << escapeString(user->getPasswordHash()) << "\n";
+        user->clearDirty();
+        ++changes;
+    }
+    if (changes == 0) {
+        return true;
+    }
+
+    // Dirty flags are already cleared, so the delta must be on disk before
+    // this returns, as for accounts
+    if (!appendDurably(deltaFile, content.str())) {
+        std::cerr << "Failed to write users delta: " << deltaFile << std::endl;
+        usersBaseKnown = false;
+        return false;
+    }
+
+    std::cout << "Saved " << changes << " changed users to " << deltaFile << std::endl;
     return true;
 }
 
-// Save all data
-bool DataPersistence::saveAll(const AccountRepository& accountRepo,
-                              const UserRepository& userRepo) {
-    bool accountsOk = saveAccounts(accountRepo);
-    bool usersOk = saveUsers(userRepo);
+// Incremental save of all data
+bool DataPersistence::checkpointAll(AccountRepository& accountRepo,
+                                    UserRepository& userRepo) {
+    bool accountsOk = checkpointAccounts(accountRepo);
+    bool usersOk = checkpointUsers(userRepo);
     return accountsOk && usersOk;
 }
 
 // Load accounts from file
 bool DataPersistence::loadAccounts(AccountRepository& repository,
                                    AccountFactory& factory) {
+    accountsBaseKnown = false;
     std::ifstream file(accountsFile);
 
     if (!file.is_open()) {
@@ -111,6 +564,20 @@ bool DataPersistence::loadAccounts(AccountRepository& repository,
     std::string header;
     std::getline(file, header);
 
+    if (header == "ACCOUNTS_V3") {
+        file.close();
+        if (!loadAccountsBinary(repository, factory)) {
+            return false;
+        }
+        size_t applied = loadAccountsDelta(repository, factory);
+        if (applied > 0) {
+            std::cout << "Applied " << applied << " account changes from "
+                      << accountsDeltaFile() << std::endl;
+        }
+        repository.markClean();
+        return true;
+    }
+
     if (header != "ACCOUNTS_V1") {
         std::cerr << "Invalid accounts file format" << std::endl;
         file.close();
@@ -127,26 +594,36 @@ bool DataPersistence::loadAccounts(AccountRepository& repository,
         std::getline(file, line);
 
         std::istringstream iss(line);
-        std::string accountType, accountNo, ownerId;
-        double balance;
+        std::string accountType, accountNo, ownerId, balanceText;
 
         // Parse: AccountType|AccountNo|OwnerID|Balance
         std::getline(iss, accountType, '|');
         std::getline(iss, accountNo, '|');
         std::getline(iss, ownerId, '|');
-        iss >> balance;
+        std::getline(iss, balanceText);
+
+        Money balance;
+        if (!Money::parse(balanceText, balance)) {
+            // Files written before Money used default double formatting
+            // (e.g. "1.23457e+06"); fall back to a floating point parse
+            try {
+                balance = Money::fromDouble(std::stod(balanceText));
+            } catch (const std::exception&) {
+                std::cerr << "Skipping account with invalid balance: " << accountNo << std::endl;
+                continue;
+            }
+        }
 
-        // Create appropriate account type
+        // V1 files carry no parameters; use the factory defaults
         Account* account = nullptr;
 
         if (accountType == "Savings") {
-            account = new SavingsAccount(unescapeString(accountNo),
-                                        unescapeString(ownerId),
-                                        balance, 0.02);
+            account = factory.restore(AccountType::Savings, unescapeString(accountNo),
+                                      unescapeString(ownerId), balance, Money(), 0.02);
         } else if (accountType == "Chequing") {
-            account = new ChequingAccount(unescapeString(accountNo),
-                                         unescapeString(ownerId),
-                                         balance, 500.0);
+            account = factory.restore(AccountType::Chequing, unescapeString(accountNo),
+                                      unescapeString(ownerId), balance,
+                                      Money::fromUnits(500), 0.0);
         }
 
         if (account) {
@@ -156,25 +633,179 @@ bool DataPersistence::loadAccounts(AccountRepository& repository,
     }
 
     file.close();
+    // A V1 file is no base for deltas; the first checkpoint rewrites it as V3
+    repository.markClean();
     std::cout << "Loaded " << loaded << " accounts from " << accountsFile << std::endl;
     return true;
 }
 
+// Load an ACCOUNTS_V3 snapshot by mapping it into memory
+bool DataPersistence::loadAccountsBinary(AccountRepository& repository,
+                                         AccountFactory& factory) {
+    int fd = ::open(accountsFile.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "No existing accounts file found: " << accountsFile << std::endl;
+        return false;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 ||
+        static_cast<std::uint64_t>(info.st_size) < sizeof(SnapshotHeader)) {
+        std::cerr << "Invalid accounts file format" << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    std::size_t size = static_cast<std::size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Failed to map accounts file: " << accountsFile << std::endl;
+        return false;
+    }
+    ::madvise(mapping, size, MADV_SEQUENTIAL);
+
+    const char* base = static_cast<const char*>(mapping);
+    SnapshotHeader header;
+    std::memcpy(&header, base, sizeof(header));
+
+    std::size_t payloadSize = size - sizeof(SnapshotHeader);
+    const std::size_t recordSize = sizeof(SnapshotRecord);
+    bool valid = std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) == 0 &&
+                 header.recordSize == recordSize &&
+                 header.recordCount <= payloadSize / recordSize &&
+                 header.stringTableSize <= payloadSize &&
+                 header.recordCount * recordSize + header.stringTableSize == payloadSize &&
+                 snapshotChecksum(base + sizeof(SnapshotHeader), payloadSize, FNV64_OFFSET) == header.checksum;
+
+    if (!valid) {
+        std::cerr << "Invalid or corrupt accounts file: " << accountsFile << std::endl;
+        ::munmap(mapping, size);
+        return false;
+    }
+
+    const char* records = base + sizeof(SnapshotHeader);
+    const char* strings = records + header.recordCount * recordSize;
+
+    // Size the account pools up front so the load is a few slab allocations
+    // (TFSAs come from the savings pool)
+    std::size_t savingsCount = 0;
+    for (std::uint64_t i = 0; i < header.recordCount; ++i) {
+        const char* typeField = records + i * recordSize + offsetof(SnapshotRecord, accountType);
+        std::uint8_t type = static_cast<std::uint8_t>(*typeField);
+        if (type == static_cast<std::uint8_t>(AccountType::Savings) ||
+            type == static_cast<std::uint8_t>(AccountType::TFSA)) {
+            ++savingsCount;
+        }
+    }
+    SavingsAccount::pool().reserve(savingsCount);
+    ChequingAccount::pool().reserve(header.recordCount - savingsCount);
+
+    size_t loaded = 0;
+    std::string accountNo;
+    std::string ownerId;
+    for (std::uint64_t i = 0; i < header.recordCount; ++i) {
+        SnapshotRecord record = decodeRecord(records + i * recordSize);
+
+        if (!recordStrings(record, strings, header.stringTableSize, accountNo, ownerId)) {
+            continue;
+        }
+
+        Account* account = accountFromRecord(factory, record, accountNo, ownerId);
+        if (account) {
+            repository.save(account);
+            loaded++;
+        }
+    }
+
+    ::munmap(mapping, size);
+    accountsBase = header.checksum;
+    accountsBaseKnown = true;
+    std::cout << "Loaded " << loaded << " accounts from " << accountsFile << std::endl;
+    return true;
+}
+
+// Apply the accounts delta batches written since the loaded snapshot
+size_t DataPersistence::loadAccountsDelta(AccountRepository& repository,
+                                          AccountFactory& factory) {
+    std::string deltaFile = accountsDeltaFile();
+    std::string contents;
+    if (!readFile(deltaFile, contents)) {
+        return 0;
+    }
+
+    size_t applied = 0;
+    std::size_t offset = 0;
+    std::string accountNo;
+    std::string ownerId;
+
+    while (contents.size() - offset >= sizeof(DeltaHeader)) {
+        DeltaHeader header;
+        std::memcpy(&header, contents.data() + offset, sizeof(header));
+
+        const char* payload = contents.data() + offset + sizeof(DeltaHeader);
+        std::size_t available = contents.size() - offset - sizeof(DeltaHeader);
+        const std::size_t recordSize = sizeof(SnapshotRecord);
+        bool valid = std::memcmp(header.magic, DELTA_MAGIC, sizeof(header.magic)) == 0 &&
+                     header.recordSize == recordSize &&
+                     header.baseChecksum == accountsBase &&
+                     header.recordCount <= available / recordSize &&
+                     header.stringTableSize <= available - header.recordCount * recordSize;
+        std::size_t payloadSize = valid ? header.recordCount * recordSize + header.stringTableSize
+                                        : 0;
+        if (!valid || snapshotChecksum(payload, payloadSize, FNV64_OFFSET) != header.checksum) {
+            break;
+        }
+
+        const char* strings = payload + header.recordCount * recordSize;
+        for (std::uint64_t i = 0; i < header.recordCount; ++i) {
+            SnapshotRecord record = decodeRecord(payload + i * recordSize);
+            if (!recordStrings(record, strings, header.stringTableSize, accountNo, ownerId)) {
+                continue;
+            }
+
+            // Upserts replace the snapshot's account; removals drop it
+            if (repository.existsAccountNo(accountNo)) {
+                repository.remove(accountNo);
+            }
+            if (record.accountType != DELTA_REMOVED) {
+                Account* account = accountFromRecord(factory, record, accountNo, ownerId);
+                if (account) {
+                    repository.save(account);
+                }
+            }
+            applied++;
+        }
+        offset += sizeof(DeltaHeader) + payloadSize;
+    }
+
+    // A torn batch from a crash, or batches extending an older snapshot;
+    // cut them off so later batches are appended after valid data
+    if (offset < contents.size()) {
+        std::cerr << "Discarding invalid accounts delta data: " << deltaFile << std::endl;
+        if (::truncate(deltaFile.c_str(), static_cast<off_t>(offset)) != 0) {
+            accountsBaseKnown = false;
+        }
+    }
+    return applied;
+}
+
 // Load users from file
 bool DataPersistence::loadUsers(UserRepository& repository) {
-    std::ifstream file(usersFile);
+    usersBaseKnown = false;
+    std::string text;
 
-    if (!file.is_open()) {
+    if (!readFile(usersFile, text)) {
         std::cerr << "No existing users file found: " << usersFile << std::endl;
         return false;
     }
 
+    std::istringstream file(text);
     std::string header;
     std::getline(file, header);
 
     if (header != "USERS_V1") {
         std::cerr << "Invalid users file format" << std::endl;
-        file.close();
         return false;
     }
 
@@ -205,11 +836,72 @@ bool DataPersistence::loadUsers(UserRepository& repository) {
         loaded++;
     }
 
-    file.close();
+    usersBase = snapshotChecksum(text.data(), text.size(), FNV64_OFFSET);
+    usersBaseKnown = true;
     std::cout << "Loaded " << loaded << " users from " << usersFile << std::endl;
+
+    size_t applied = loadUsersDelta(repository);
+    if (applied > 0) {
+        std::cout << "Applied " << applied << " user changes from "
+                  << usersDeltaFile() << std::endl;
+    }
+    repository.markClean();
     return true;
 }
 
+// Apply the users delta written since the loaded users file
+size_t DataPersistence::loadUsersDelta(UserRepository& repository) {
+    std::string deltaFile = usersDeltaFile();
+    std::string text;
+    if (!readFile(deltaFile, text)) {
+        return 0;
+    }
+
+    size_t applied = 0;
+    std::size_t offset = 0;
+    std::string expectedHeader = std::string(USERS_DELTA_HEADER) + " " + std::to_string(usersBase);
+
+    // Only complete lines count; a line cut short by a crash is dropped
+    for (std::size_t end; (end = text.find('\n', offset)) != std::string::npos; offset = end + 1) {
+        std::string line = text.substr(offset, end - offset);
+
+        if (offset == 0) {
+            if (line != expectedHeader) {
+                break;  // Extends an older users file
+            }
+            continue;
+        }
+
+        std::istringstream iss(line);
+        std::string op, userId, name, email, passwordHash;
+        std::getline(iss, op, '|');
+        std::getline(iss, userId, '|');
+
+        if (op == "-") {
+            if (repository.existsUserId(userId)) {
+                repository.remove(userId);
+            }
+        } else if (op == "+") {
+            std::getline(iss, name, '|');
+            std::getline(iss, email, '|');
+            std::getline(iss, passwordHash, '|');
+            repository.save(User(unescapeString(userId), unescapeString(name),
+                                 unescapeString(email), unescapeString(passwordHash)));
+        } else {
+            break;
+        }
+        applied++;
+    }
+
+    if (offset < text.size()) {
+        std::cerr << "Discarding invalid users delta data: " << deltaFile << std::endl;
+        if (::truncate(deltaFile.c_str(), static_cast<off_t>(offset)) != 0) {
+            usersBaseKnown = false;
+        }
+    }
+    return applied;
+}
+
 // Load all data
 bool DataPersistence::loadAll(AccountRepository& accountRepo,
                               UserRepository& userRepo,
@@ -238,10 +930,13 @@ bool DataPersistence::usersFileExists() const {
 
 // Clear accounts file
 bool DataPersistence::clearAccountsFile() {
+    std::remove(accountsDeltaFile().c_str());
+    historyArchive.remove();
     return (remove(accountsFile.c_str()) == 0);
 }
 
 // Clear users file
 bool DataPersistence::clearUsersFile() {
+    std::remove(usersDeltaFile().c_str());
     return (remove(usersFile.c_str()) == 0);
-}
\ No newline at end of file
+}
@@ -1,33 +1,81 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include "AccountRepository.h"
 #include "UserRepository.h"
 #include "AccountFactory.h"
+#include "HistoryArchive.h"
 
 /**
  * DataPersistence - Handles saving and loading system data
  * Provides file-based persistence for accounts and users
+ *
+ * Accounts are saved as an ACCOUNTS_V3 binary snapshot (fixed-width
+ * records plus a string table, checksummed) holding every account
+ * parameter, the last interest accrual time and the position of the
+ * account's saved transaction history; text ACCOUNTS_V1 files from older
+ * versions are still loaded. Users use the USERS_V1 text format.
+ *
+ * Transaction history goes to a HistoryArchive next to the snapshot
+ * (accounts file + ".history"). Saves append only the postings recorded
+ * since the previous save, and loading reads no history at all; it is
+ * fetched per account when viewed (see BankSystem::getTransactionHistory).
+ *
+ * Checkpoints are incremental: only accounts and users changed since the
+ * last save (see Account::isDirty, User::isDirty) are appended to a delta
+ * file next to the base file, and loading applies the delta on top of the
+ * base. Each delta records the checksum of the base it extends, so a delta
+ * left behind by a crash during a full save is ignored rather than applied
+ * to the newer base. Once a delta grows past half the size of its base it
+ * is compacted by a full save.
  */
 class DataPersistence {
 private:
     std::string accountsFile;
     std::string usersFile;
+    HistoryArchive historyArchive;
+
+    // Checksums of the base files the delta files extend; unknown until a
+    // base has been loaded or saved, in which case checkpoints do full saves
+    std::uint64_t accountsBase;
+    bool accountsBaseKnown;
+    std::uint64_t usersBase;
+    bool usersBaseKnown;
+
+    std::string accountsDeltaFile() const;
+    std::string usersDeltaFile() const;
 
     // Helper methods for JSON-style formatting
     static std::string escapeString(const std::string& str);
     static std::string unescapeString(const std::string& str);
 
+    // Load an ACCOUNTS_V3 binary snapshot (memory-mapped)
+    bool loadAccountsBinary(AccountRepository& repository, AccountFactory& factory);
+
+    // Apply the delta files on top of a loaded base; an invalid or torn
+    // tail is cut off. Return the number of records applied.
+    size_t loadAccountsDelta(AccountRepository& repository, AccountFactory& factory);
+    size_t loadUsersDelta(UserRepository& repository);
+
 public:
     // Constructor
     DataPersistence(const std::string& accountsFile = "accounts.dat",
                    const std::string& usersFile = "users.dat");
 
-    // Save operations
-    bool saveAccounts(const AccountRepository& repository);
-    bool saveUsers(const UserRepository& repository);
-    bool saveAll(const AccountRepository& accountRepo,
-                const UserRepository& userRepo);
+    // Save operations - full rewrite of the base file; discards the delta
+    bool saveAccounts(AccountRepository& repository);
+    bool saveUsers(UserRepository& repository);
+    bool saveAll(AccountRepository& accountRepo,
+                UserRepository& userRepo);
+
+    // Incremental save operations - append changed records to the delta,
+    // or do a full save when there is no base yet or the delta is due for
+    // compaction
+    bool checkpointAccounts(AccountRepository& repository);
+    bool checkpointUsers(UserRepository& repository);
+    bool checkpointAll(AccountRepository& accountRepo,
+                      UserRepository& userRepo);
 
     // Load operations
     bool loadAccounts(AccountRepository& repository, AccountFactory& factory);
@@ -35,6 +83,9 @@ public:
     bool loadAll(AccountRepository& accountRepo, UserRepository& userRepo,
                 AccountFactory& factory);
 
+    // Archive holding the saved transaction history of loaded accounts
+    HistoryArchive& getHistoryArchive();
+
     // File management
     bool accountsFileExists() const;
     bool usersFileExists() const;
@@ -1,26 +1,28 @@
 #include "DepositTransaction.h"
-#include <iostream>
-#include <sstream>
+#include "Logger.h"
+#include "OutputBuffer.h"
+#include <mutex>
 
 // Constructor
-DepositTransaction::DepositTransaction(Account& account, double amount,
+DepositTransaction::DepositTransaction(Account& account, Money amount,
     const Timestamp& timestamp, const std::string& description)
-    : Transaction("DEP-" + account.getAccountNo() + "-" + timestamp.toString(),
-                  timestamp, description), account(account), amount(amount),
+    : Transaction("DEP", timestamp, description), account(account), amount(amount),
                     executed(false) {
 }
 
 // Execute the deposit
 bool DepositTransaction::execute() {
+    std::lock_guard<std::mutex> lock(account.getMutex());
+
     if (executed) {
-        std::cerr << "Transaction already executed!" << std::endl;
+        LOG_WARN("Transaction already executed!");
         return false;
     }
 
     if (account.deposit(amount)) {
         executed = true;
-        std::cout << "Deposit executed: $" << amount
-                  << " to account " << account.getAccountNo() << std::endl;
+        recordPosting(transactionId, TransactionJournal::RecordType::Deposit, account, amount);
+        LOG_DEBUG("Deposit executed: $", amount, " to account ", account.getAccountNo());
         return true;
     }
 
@@ -29,38 +31,42 @@ bool DepositTransaction::execute() {
 
 // Undo the deposit (withdraw the amount)
 bool DepositTransaction::undo() {
+    std::lock_guard<std::mutex> lock(account.getMutex());
+
     if (!executed) {
-        std::cerr << "Cannot undo: Transaction not executed!" << std::endl;
+        LOG_WARN("Cannot undo: Transaction not executed!");
         return false;
     }
 
     if (account.withdraw(amount)) {
         executed = false;
-        std::cout << "Deposit undone: $" << amount
-                  << " withdrawn from account " << account.getAccountNo() << std::endl;
+        recordPosting(TransactionIdGenerator::next(), TransactionJournal::RecordType::Withdraw,
+                      account, amount);
+        LOG_DEBUG("Deposit undone: $", amount, " withdrawn from account ",
+                  account.getAccountNo());
         return true;
     }
 
-    std::cerr << "Failed to undo deposit - insufficient funds" << std::endl;
+    LOG_WARN("Failed to undo deposit - insufficient funds");
     return false;
 }
 
-// Create detailed record
-std::string DepositTransaction::record() const {
-    std::stringstream ss;
-    ss << Transaction::record() << "\n";
-    ss << "Type: Deposit\n";
-    ss << "Account: " << account.getAccountNo() << "\n";
-    ss << "Amount: $" << amount << "\n";
-    ss << "Status: " << (executed ? "Executed" : "Not Executed");
-    return ss.str();
+// Append detailed record
+void DepositTransaction::formatTo(OutputBuffer& out) const {
+    Transaction::formatTo(out);
+    out.append("\nType: Deposit\nAccount: ");
+    out.append(account.getAccountNo());
+    out.append("\nAmount: $");
+    out.appendChars(amount);
+    out.append("\nStatus: ");
+    out.append(executed ? "Executed" : "Not Executed");
 }
 
 // Getters
-double DepositTransaction::getAmount() const {
+Money DepositTransaction::getAmount() const {
     return amount;
 }
 
-std::string DepositTransaction::getAccountNo() const {
+const std::string& DepositTransaction::getAccountNo() const {
     return account.getAccountNo();
 }
\ No newline at end of file
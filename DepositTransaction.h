@@ -9,22 +9,22 @@
 class DepositTransaction : public Transaction {
 private:
     Account& account;
-    double amount;
+    Money amount;
     bool executed;  // Track if transaction has been executed
 
 public:
     // Constructor
-    DepositTransaction(Account& account, double amount, const Timestamp& timestamp,
+    DepositTransaction(Account& account, Money amount, const Timestamp& timestamp,
                       const std::string& description);
 
     // Implementation of pure virtual methods
     bool execute() override;
     bool undo() override;
 
-    // Override record to include deposit-specific details
-    std::string record() const override;
+    // Extend the record with deposit-specific details
+    void formatTo(OutputBuffer& out) const override;
 
     // Getters
-    double getAmount() const;
-    std::string getAccountNo() const;
+    Money getAmount() const;
+    const std::string& getAccountNo() const;
 };
\ No newline at end of file
@@ -0,0 +1,406 @@
+#include "HistoryArchive.h"
+#include "HistoryIndex.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// File layout (native byte order):
+//   ARCHIVE_MAGIC | block*
+//   block = BlockHeader | BlockRecord[count] | string table
+// Counterparty account numbers live in the block's string table.
+static const char ARCHIVE_MAGIC[8] = {'B', 'A', 'N', 'K', 'H', 'I', 'S', '1'};
+static const std::uint32_t BLOCK_MAGIC = 0x4B4C4248;   // "HBLK"
+
+// Largest block we accept when reading (guards against garbage headers)
+static const std::uint32_t MAX_BLOCK_ENTRIES = 1 << 24;
+
+struct BlockHeader {
+    std::uint32_t magic;
+    std::uint32_t count;
+    std::uint64_t previous;
+    std::int64_t minTimeMicros;
+    std::int64_t maxTimeMicros;
+    std::uint32_t stringTableSize;
+    std::uint32_t checksum;         // Over the records and string table
+};
+
+struct BlockRecord {
+    std::uint64_t id;
+    std::int64_t timeMicros;
+    std::int64_t amountCents;
+    std::int64_t balanceAfterCents;
+    std::uint32_t counterpartyOffset;
+    std::uint16_t counterpartyLength;
+    std::uint8_t kind;
+    std::uint8_t reserved;
+};
+
+// FNV-1a checksum
+static std::uint32_t blockChecksum(const char* data, std::size_t size) {
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Read exactly size bytes at offset
+static bool readAt(int fd, std::uint64_t offset, char* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t n = ::pread(fd, data, size, static_cast<off_t>(offset));
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+        offset += static_cast<std::uint64_t>(n);
+    }
+    return true;
+}
+
+// Constructor
+HistoryArchive::HistoryArchive(const std::string& path)
+    : path(path), fd(-1), endOffset(0), generation(0) {
+}
+
+// Destructor
+HistoryArchive::~HistoryArchive() {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+// Open (or create) the file; caller holds the mutex
+bool HistoryArchive::ensureOpen() {
+    if (fd >= 0) {
+        return true;
+    }
+
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        std::cerr << "Failed to open history archive: " << path << std::endl;
+        return false;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+
+    endOffset = static_cast<std::uint64_t>(info.st_size);
+    if (endOffset == 0) {
+        if (::pwrite(fd, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC), 0) !=
+            static_cast<ssize_t>(sizeof(ARCHIVE_MAGIC))) {
+            std::cerr << "Failed to initialize history archive: " << path << std::endl;
+            ::close(fd);
+            fd = -1;
+            return false;
+        }
+        endOffset = sizeof(ARCHIVE_MAGIC);
+        return true;
+    }
+
+    char magic[sizeof(ARCHIVE_MAGIC)];
+    if (endOffset < sizeof(magic) || !readAt(fd, 0, magic, sizeof(magic)) ||
+        std::memcmp(magic, ARCHIVE_MAGIC, sizeof(magic)) != 0) {
+        std::cerr << "Invalid history archive format: " << path << std::endl;
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    return true;
+}
+
+// Encode one block onto the staging buffer; caller holds the mutex
+std::uint64_t HistoryArchive::stageBlock(std::uint64_t previous, const HistoryEntry* entries,
+                                         size_t count) {
+    std::vector<BlockRecord> records(count);
+    std::string strings;
+    std::unordered_map<StringInterner::Handle, std::uint32_t> counterparties;
+    BlockHeader header = {};
+    header.magic = BLOCK_MAGIC;
+    header.count = static_cast<std::uint32_t>(count);
+    header.previous = previous;
+    header.minTimeMicros = entries[0].timeMicros;
+    header.maxTimeMicros = entries[0].timeMicros;
+
+    for (size_t i = 0; i < count; ++i) {
+        const HistoryEntry& entry = entries[i];
+        BlockRecord& record = records[i];
+        record = {};
+        record.id = entry.id.getValue();
+        record.timeMicros = entry.timeMicros;
+        record.amountCents = entry.amount.getCents();
+        record.balanceAfterCents = entry.balanceAfter.getCents();
+        record.kind = static_cast<std::uint8_t>(entry.kind);
+
+        if (entry.counterparty != StringInterner::INVALID_HANDLE) {
+            auto found = counterparties.find(entry.counterparty);
+            if (found == counterparties.end()) {
+                found = counterparties.emplace(entry.counterparty,
+                                               static_cast<std::uint32_t>(strings.size())).first;
+                strings += entry.getCounterpartyNo();
+            }
+            record.counterpartyOffset = found->second;
+            record.counterpartyLength = static_cast<std::uint16_t>(entry.getCounterpartyNo().size());
+        }
+
+        header.minTimeMicros = std::min(header.minTimeMicros, entry.timeMicros);
+        header.maxTimeMicros = std::max(header.maxTimeMicros, entry.timeMicros);
+    }
+
+    std::size_t recordBytes = count * sizeof(BlockRecord);
+    std::size_t blockStart = staged.size();
+    staged.resize(blockStart + sizeof(BlockHeader) + recordBytes + strings.size());
+    char* payload = staged.data() + blockStart + sizeof(BlockHeader);
+    std::memcpy(payload, records.data(), recordBytes);
+    std::memcpy(payload + recordBytes, strings.data(), strings.size());
+
+    header.stringTableSize = static_cast<std::uint32_t>(strings.size());
+    header.checksum = blockChecksum(payload, recordBytes + strings.size());
+    std::memcpy(staged.data() + blockStart, &header, sizeof(header));
+
+    return endOffset + blockStart;
+}
+
+// Stage entries as a run of blocks of at most BLOCK_ENTRIES
+std::uint64_t HistoryArchive::stage(std::uint64_t previous, const HistoryEntry* entries,
+                                    size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (count == 0 || !ensureOpen()) {
+        return 0;
+    }
+
+    for (size_t first = 0; first < count; first += BLOCK_ENTRIES) {
+        previous = stageBlock(previous, entries + first, std::min<size_t>(BLOCK_ENTRIES, count - first));
+    }
+    return previous;
+}
+
+// Write staged blocks
+bool HistoryArchive::commit() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (staged.empty()) {
+        return true;
+    }
+
+    const char* data = staged.data();
+    std::size_t remaining = staged.size();
+    std::uint64_t offset = endOffset;
+    bool ok = fd >= 0;
+    while (ok && remaining > 0) {
+        ssize_t n = ::pwrite(fd, data, remaining, static_cast<off_t>(offset));
+        if (n <= 0) {
+            ok = false;
+            break;
+        }
+        data += n;
+        remaining -= static_cast<std::size_t>(n);
+        offset += static_cast<std::uint64_t>(n);
+    }
+    ok = ok && ::fsync(fd) == 0;
+
+    if (!ok) {
+        std::cerr << "Failed to write history archive: " << path << std::endl;
+        // Cut off any partial write so the next commit lands where stage() said
+        if (fd >= 0 && ::ftruncate(fd, static_cast<off_t>(endOffset)) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+        staged.clear();
+        ++generation;
+        return false;
+    }
+
+    endOffset += staged.size();
+    staged.clear();
+    return true;
+}
+
+std::uint64_t HistoryArchive::getGeneration() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return generation;
+}
+
+// Read and validate a block header
+bool HistoryArchive::readBlockInfo(std::uint64_t offset, BlockInfo& info) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!ensureOpen()) {
+        return false;
+    }
+
+    BlockHeader header;
+    if (offset < sizeof(ARCHIVE_MAGIC) || offset > endOffset ||
+        endOffset - offset < sizeof(BlockHeader) ||
+        !readAt(fd, offset, reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.magic != BLOCK_MAGIC || header.count == 0 || header.count > MAX_BLOCK_ENTRIES ||
+        header.previous >= offset) {
+        std::cerr << "Invalid history block at offset " << offset << " in " << path << std::endl;
+        return false;
+    }
+
+    info.offset = offset;
+    info.previous = header.previous;
+    info.count = header.count;
+    info.minTimeMicros = header.minTimeMicros;
+    info.maxTimeMicros = header.maxTimeMicros;
+    return true;
+}
+
+// Decode one block
+bool HistoryArchive::readBlock(std::uint64_t offset, std::vector<HistoryEntry>& out,
+                               BlockInfo* info) {
+    std::vector<char> payload;
+    BlockHeader header;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!ensureOpen()) {
+            return false;
+        }
+
+        bool valid = offset >= sizeof(ARCHIVE_MAGIC) && offset <= endOffset &&
+                     endOffset - offset >= sizeof(BlockHeader) &&
+                     readAt(fd, offset, reinterpret_cast<char*>(&header), sizeof(header)) &&
+                     header.magic == BLOCK_MAGIC && header.count <= MAX_BLOCK_ENTRIES;
+        std::uint64_t payloadSize = valid ? std::uint64_t(header.count) * sizeof(BlockRecord) +
+                                            header.stringTableSize
+                                          : 0;
+        valid = valid && payloadSize <= endOffset - offset - sizeof(BlockHeader);
+        if (valid) {
+            payload.resize(static_cast<std::size_t>(payloadSize));
+            valid = readAt(fd, offset + sizeof(BlockHeader), payload.data(), payload.size()) &&
+                    blockChecksum(payload.data(), payload.size()) == header.checksum;
+        }
+        if (!valid || header.count == 0 || header.previous >= offset) {
+            std::cerr << "Invalid history block at offset " << offset << " in " << path << std::endl;
+            return false;
+        }
+    }
+
+    if (info != nullptr) {
+        info->offset = offset;
+        info->previous = header.previous;
+        info->count = header.count;
+        info->minTimeMicros = header.minTimeMicros;
+        info->maxTimeMicros = header.maxTimeMicros;
+    }
+
+    const char* strings = payload.data() + header.count * sizeof(BlockRecord);
+    StringInterner& accountNumbers = StringInterner::accountNumbers();
+    out.reserve(out.size() + header.count);
+
+    for (std::uint32_t i = 0; i < header.count; ++i) {
+        BlockRecord record;
+        std::memcpy(&record, payload.data() + i * sizeof(BlockRecord), sizeof(record));
+
+        HistoryEntry entry;
+        entry.id = TransactionId(record.id);
+        entry.timeMicros = record.timeMicros;
+        entry.amount = Money::fromCents(record.amountCents);
+        entry.balanceAfter = Money::fromCents(record.balanceAfterCents);
+        entry.kind = static_cast<HistoryEntry::Kind>(record.kind);
+        if (record.counterpartyLength > 0 &&
+            record.counterpartyOffset <= header.stringTableSize &&
+            record.counterpartyLength <= header.stringTableSize - record.counterpartyOffset) {
+            entry.counterparty = accountNumbers.intern(
+                std::string(strings + record.counterpartyOffset, record.counterpartyLength));
+        }
+        out.push_back(entry);
+    }
+    return true;
+}
+
+// Walk a chain from its newest block back to the oldest
+bool HistoryArchive::readChain(std::uint64_t head, std::vector<HistoryEntry>& out) {
+    std::vector<std::uint64_t> blocks;
+    for (std::uint64_t offset = head; offset != 0;) {
+        BlockInfo info;
+        if (!readBlockInfo(offset, info)) {
+            return false;
+        }
+        blocks.push_back(offset);
+        offset = info.previous;
+    }
+
+    for (auto it = blocks.rbegin(); it != blocks.rend(); ++it) {
+        if (!readBlock(*it, out)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Index a chain, starting from the newest chain indexed before
+std::shared_ptr<const HistoryIndex> HistoryArchive::index(std::uint64_t head) {
+    std::vector<BlockInfo> newer;
+    std::shared_ptr<const HistoryIndex> base;
+    for (std::uint64_t offset = head; offset != 0;) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto found = indexes.find(offset);
+            if (found != indexes.end()) {
+                recentHeads.splice(recentHeads.begin(), recentHeads, found->second.recent);
+                base = found->second.index;
+                break;
+            }
+        }
+
+        BlockInfo info;
+        if (!readBlockInfo(offset, info)) {
+            return nullptr;
+        }
+        newer.push_back(info);
+        offset = info.previous;
+    }
+
+    if (newer.empty() && base) {
+        return base;
+    }
+
+    auto built = base ? std::make_shared<HistoryIndex>(*base) : std::make_shared<HistoryIndex>();
+    for (auto it = newer.rbegin(); it != newer.rend(); ++it) {
+        built->append(*it);
+    }
+
+    // Chains only grow at the head; the older head's entry is superseded
+    std::lock_guard<std::mutex> lock(mutex);
+    if (base) {
+        auto superseded = indexes.find(base->getHead());
+        if (superseded != indexes.end()) {
+            recentHeads.erase(superseded->second.recent);
+            indexes.erase(superseded);
+        }
+    }
+    if (head != 0 && indexes.find(head) == indexes.end()) {
+        recentHeads.push_front(head);
+        indexes[head] = {built, recentHeads.begin()};
+        if (indexes.size() > INDEX_CACHE_CHAINS) {
+            indexes.erase(recentHeads.back());
+            recentHeads.pop_back();
+        }
+    }
+    return built;
+}
+
+// Delete the archive file
+bool HistoryArchive::remove() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    staged.clear();
+    indexes.clear();
+    recentHeads.clear();
+    ++generation;
+    endOffset = 0;
+    return std::remove(path.c_str()) == 0;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "HistoryEntry.h"
+
+class HistoryIndex;
+
+/**
+ * HistoryArchive - Append-only file of saved transaction history
+ *
+ * Each save appends, per account with new postings, one block holding just
+ * those postings and the offset of the account's previous block, so an
+ * account's history is a chain of blocks ending at its newest one (the
+ * "head", stored in the account snapshot). Saving is proportional to the
+ * new postings, never to the history already on disk, and nothing is read
+ * at startup: a chain is only walked when someone asks for that history.
+ *
+ * Blocks are immutable once written; each carries its time range and a
+ * checksum, and holds at most BLOCK_ENTRIES entries, so reading one page
+ * of history never decodes more than a block beyond the page. Offset 0 is
+ * never a block (the file starts with a header), so a head of 0 means "no
+ * saved history".
+ *
+ * Thread-safe. The file is opened on first use.
+ */
+class HistoryArchive {
+public:
+    // Most entries per block; larger stages are split into a run of blocks
+    static const std::uint32_t BLOCK_ENTRIES = 256;
+
+    // Most chain indexes kept in memory; the least recently used goes first
+    static const size_t INDEX_CACHE_CHAINS = 256;
+
+    // Summary of one block, as stored in its header
+    struct BlockInfo {
+        std::uint64_t offset = 0;
+        std::uint64_t previous = 0;     // Older block of the same account (0 = none)
+        std::uint32_t count = 0;
+        std::int64_t minTimeMicros = 0;
+        std::int64_t maxTimeMicros = 0;
+    };
+
+private:
+    std::string path;
+    int fd;
+    std::uint64_t endOffset;        // Size of the committed file
+    std::vector<char> staged;       // Encoded blocks not yet written
+    std::uint64_t generation;       // Bumped whenever staged blocks are dropped
+    // Index of recently read chains, keyed by head, most recent first
+    struct CachedIndex {
+        std::shared_ptr<const HistoryIndex> index;
+        std::list<std::uint64_t>::iterator recent;
+    };
+    std::unordered_map<std::uint64_t, CachedIndex> indexes;
+    std::list<std::uint64_t> recentHeads;
+    mutable std::mutex mutex;
+
+    bool ensureOpen();
+    std::uint64_t stageBlock(std::uint64_t previous, const HistoryEntry* entries, size_t count);
+
+public:
+    explicit HistoryArchive(const std::string& path);
+    ~HistoryArchive();
+
+    HistoryArchive(const HistoryArchive&) = delete;
+    HistoryArchive& operator=(const HistoryArchive&) = delete;
+
+    const std::string& getPath() const { return path; }
+
+    // Stage entries that follow the block at previous; returns the offset
+    // their newest block will have once committed (0 on failure)
+    std::uint64_t stage(std::uint64_t previous, const HistoryEntry* entries, size_t count);
+
+    // Write and fsync all staged blocks; on failure they are dropped
+    bool commit();
+
+    // Changes whenever staged blocks are dropped. Stagers compare it before
+    // and after commit: another thread's commit may have written (or lost)
+    // their blocks
+    std::uint64_t getGeneration() const;
+
+    // Header of the block at offset
+    bool readBlockInfo(std::uint64_t offset, BlockInfo& info);
+
+    // Entries of one block, oldest first, appended to out (and its header
+    // to info, if given)
+    bool readBlock(std::uint64_t offset, std::vector<HistoryEntry>& out,
+                   BlockInfo* info = nullptr);
+
+    // All entries of the chain ending at head, oldest first, appended to out
+    bool readChain(std::uint64_t head, std::vector<HistoryEntry>& out);
+
+    // Block index of the chain ending at head (nullptr if it cannot be read).
+    // Cached for the INDEX_CACHE_CHAINS most recently read chains: extending
+    // a cached chain to a newer head only reads the headers of the new blocks
+    std::shared_ptr<const HistoryIndex> index(std::uint64_t head);
+
+    // Delete the file (and anything staged)
+    bool remove();
+};
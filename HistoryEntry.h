@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Money.h"
+#include "StringInterner.h"
+#include "Timestamp.h"
+#include "TransactionId.h"
+
+/**
+ * HistoryEntry - One posting in an account's transaction history
+ *
+ * A plain value (no pointers to accounts or transactions), so history can
+ * outlive the Transaction objects that produced it and be written to and
+ * read back from the history archive as-is.
+ */
+struct HistoryEntry {
+    enum class Kind : std::uint8_t {
+        Deposit = 1,
+        Withdraw = 2,
+        TransferOut = 3,
+        TransferIn = 4,
+        Interest = 5
+    };
+
+    TransactionId id;
+    std::int64_t timeMicros = 0;        // Microseconds since the Unix epoch
+    Money amount;
+    Money balanceAfter;                 // Balance of the account after the posting
+    StringInterner::Handle counterparty = StringInterner::INVALID_HANDLE;  // Transfers only
+    Kind kind = Kind::Deposit;
+
+    Timestamp getTimestamp() const {
+        return Timestamp(std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::microseconds(timeMicros))));
+    }
+
+    // Counterparty account number (empty if none)
+    const std::string& getCounterpartyNo() const {
+        static const std::string none;
+        return counterparty == StringInterner::INVALID_HANDLE
+                   ? none
+                   : StringInterner::accountNumbers().view(counterparty);
+    }
+
+    static const char* kindName(Kind kind) {
+        switch (kind) {
+            case Kind::Deposit: return "Deposit";
+            case Kind::Withdraw: return "Withdraw";
+            case Kind::TransferOut: return "TransferOut";
+            case Kind::TransferIn: return "TransferIn";
+            case Kind::Interest: return "Interest";
+        }
+        return "Unknown";
+    }
+
+    static std::int64_t toMicros(const Timestamp& timestamp) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            timestamp.getTimePoint().time_since_epoch()).count();
+    }
+};
+
+/**
+ * HistoryCursor - Position in an account's history for paged reads
+ *
+ * Entries are numbered from 0 (oldest) in posting order; a page holds the
+ * entries just below position, newest first. Positions stay valid across
+ * saves because saving only moves entries to the archive, never reorders
+ * them. block/blockEnd remember the archive block holding entry
+ * position - 1, so the next page starts reading right there.
+ */
+struct HistoryCursor {
+    static const std::uint64_t NEWEST = ~std::uint64_t(0);
+
+    std::uint64_t position = NEWEST;    // Entries below this come next
+    std::uint64_t block = 0;            // Archive block hint (0 = none)
+    std::uint64_t blockEnd = 0;         // Position just past that block's newest entry
+
+    bool atOldest() const { return position == 0; }
+};
+
+// One page of history, newest first
+struct HistoryPage {
+    std::vector<HistoryEntry> entries;
+    HistoryCursor next;                 // Pass back for the following (older) page
+    bool hasMore = false;
+};
@@ -0,0 +1,52 @@
+#include "HistoryIndex.h"
+#include <algorithm>
+
+// Constructor
+HistoryIndex::HistoryIndex() : entryCount(0) {
+}
+
+// Append a block and fold its time span into the running bounds
+void HistoryIndex::append(const HistoryArchive::BlockInfo& info) {
+    Block block;
+    block.offset = info.offset;
+    block.firstPosition = entryCount;
+    block.count = info.count;
+    block.minTimeMicros = info.minTimeMicros;
+    block.maxTimeMicros = info.maxTimeMicros;
+    block.maxTimeSoFar = blocks.empty()
+        ? info.maxTimeMicros
+        : std::max(blocks.back().maxTimeSoFar, info.maxTimeMicros);
+    block.minTimeAfter = info.minTimeMicros;
+
+    // Only a back-dated block lowers the bound of older ones
+    for (auto it = blocks.rbegin(); it != blocks.rend() && it->minTimeAfter > info.minTimeMicros; ++it) {
+        it->minTimeAfter = info.minTimeMicros;
+    }
+
+    blocks.push_back(block);
+    entryCount += info.count;
+}
+
+// Both bounds are monotonic along the list, so each end is a binary search
+void HistoryIndex::findTimeRange(std::int64_t fromMicros, std::int64_t toMicros,
+                                 size_t& first, size_t& last) const {
+    auto begin = std::partition_point(blocks.begin(), blocks.end(), [fromMicros](const Block& block) {
+        return block.maxTimeSoFar < fromMicros;
+    });
+    auto end = std::partition_point(begin, blocks.end(), [toMicros](const Block& block) {
+        return block.minTimeAfter < toMicros;
+    });
+    first = static_cast<size_t>(begin - blocks.begin());
+    last = static_cast<size_t>(end - blocks.begin());
+}
+
+// Find the block holding position
+size_t HistoryIndex::findPosition(std::uint64_t position) const {
+    if (position >= entryCount) {
+        return blocks.size();
+    }
+    auto it = std::partition_point(blocks.begin(), blocks.end(), [position](const Block& block) {
+        return block.firstPosition + block.count <= position;
+    });
+    return static_cast<size_t>(it - blocks.begin());
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "HistoryArchive.h"
+
+/**
+ * HistoryIndex - Block list of one account's saved history chain
+ *
+ * The archive stores a chain newest-first through back pointers; this
+ * lays it out oldest-first with each block's position and time span, so
+ * "postings between T1 and T2" and "the entry at position N" become
+ * binary searches over the block list instead of a walk over the chain.
+ *
+ * Postings are usually appended in time order, but nothing guarantees it
+ * (journal replay, back-dated interest). Each block therefore also keeps
+ * the latest time in it or any older block and the earliest time in it or
+ * any newer block; both are monotonic along the list, so a time range
+ * search stays exact whatever the order.
+ *
+ * Immutable once published by HistoryArchive::index; a newer head gets a
+ * new index built by extending the old one.
+ */
+class HistoryIndex {
+public:
+    struct Block {
+        std::uint64_t offset;
+        std::uint64_t firstPosition;    // Position of the block's oldest entry
+        std::uint32_t count;
+        std::int64_t minTimeMicros;
+        std::int64_t maxTimeMicros;
+        std::int64_t maxTimeSoFar;      // Latest time in this or any older block
+        std::int64_t minTimeAfter;      // Earliest time in this or any newer block
+    };
+
+private:
+    std::vector<Block> blocks;          // Oldest first
+    std::uint64_t entryCount;
+
+public:
+    HistoryIndex();
+
+    // Add the block following the current newest one
+    void append(const HistoryArchive::BlockInfo& info);
+
+    const std::vector<Block>& getBlocks() const { return blocks; }
+    std::uint64_t getHead() const { return blocks.empty() ? 0 : blocks.back().offset; }
+    std::uint64_t getEntryCount() const { return entryCount; }
+
+    // Blocks [first, last) that may hold entries timed in [fromMicros, toMicros)
+    void findTimeRange(std::int64_t fromMicros, std::int64_t toMicros,
+                       size_t& first, size_t& last) const;
+
+    // Block holding the entry at position (blocks.size() if out of range)
+    size_t findPosition(std::uint64_t position) const;
+};
@@ -0,0 +1,145 @@
+#include "InterestEngine.h"
+#include "SavingsAccount.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+// Interest in whole cents for each account, over the gathered arrays so the
+// accounts themselves are not touched outside their locks
+static void computeInterest(const std::int64_t* balances, const double* factors,
+                            double* interest, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        interest[i] = std::round(static_cast<double>(balances[i]) * factors[i]);
+    }
+}
+
+// Constructor
+InterestEngine::InterestEngine(AccountRepository& accounts, ThreadPool& pool)
+    : accounts(accounts), pool(pool), journal(nullptr), ledger(nullptr) {
+}
+
+// Enable/disable journaling
+void InterestEngine::setJournal(TransactionJournal* journal) {
+    this->journal = journal;
+}
+
+// Ledger mirroring the accounts
+void InterestEngine::setLedger(Ledger* ledger) {
+    this->ledger = ledger;
+}
+
+// Accrue interest on all savings accounts
+InterestReport InterestEngine::applyAll(const Timestamp& now) {
+    std::vector<SavingsAccount*> savings;
+    for (Account* account : accounts.getAllAccounts()) {
+        if (auto* savingsAccount = dynamic_cast<SavingsAccount*>(account)) {
+            savings.push_back(savingsAccount);
+        }
+    }
+
+    const std::int64_t timeMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+        now.getTimePoint().time_since_epoch()).count();
+
+    InterestReport report;
+    report.accountsScanned = savings.size();
+    std::uint64_t lastLsn = 0;
+    std::mutex reportMutex;
+
+    auto processChunk = [&](size_t begin, size_t end) {
+        size_t count = end - begin;
+        std::vector<std::int64_t> balances(count);
+        std::vector<double> factors(count);
+        std::vector<double> interest(count);
+
+        // Gather: snapshot balance and accrual factor per account
+        for (size_t i = 0; i < count; ++i) {
+            SavingsAccount* account = savings[begin + i];
+            std::lock_guard<std::mutex> lock(account->getMutex());
+            double days = now.daysSince(account->getLastInterestApplied());
+            balances[i] = account->getBalance().getCents();
+            factors[i] = (account->getInterestRate() / 365.0) * days;
+        }
+
+        computeInterest(balances.data(), factors.data(), interest.data(), count);
+
+        // Apply: credit under the account lock, journaling in apply order
+        size_t credited = 0;
+        Money total;
+        std::uint64_t chunkLsn = 0;
+
+        auto mergeChunk = [&]() {
+            std::lock_guard<std::mutex> lock(reportMutex);
+            report.accountsCredited += credited;
+            report.totalInterest += total;
+            lastLsn = std::max(lastLsn, chunkLsn);
+        };
+
+        try {
+            for (size_t i = 0; i < count; ++i) {
+                SavingsAccount* account = savings[begin + i];
+                Money credit;
+                {
+                    std::lock_guard<std::mutex> lock(account->getMutex());
+                    Money before = account->getBalance();
+
+                    if (before.getCents() == balances[i]) {
+                        if (!(interest[i] >= 1.0)) {
+                            continue;
+                        }
+                        if (interest[i] >= 9223372036854775808.0) {
+                            throw std::overflow_error("Interest amount out of range");
+                        }
+                        credit = Money::fromCents(static_cast<std::int64_t>(interest[i]));
+                        account->creditInterest(credit, now);
+                    } else {
+                        // Posted to since the gather pass; recompute for this account
+                        if (!account->applyInterest(now)) {
+                            continue;
+                        }
+                        credit = account->getBalance() - before;
+                    }
+
+                    if (journal != nullptr) {
+                        TransactionJournal::Record record;
+                        record.type = TransactionJournal::RecordType::Interest;
+                        record.accountNo = account->getAccountNo();
+                        record.amount = credit;
+                        record.balanceAfter = account->getBalance();
+                        record.timeMicros = timeMicros;
+                        record.transactionId = account->getLastHistoryId().getValue();
+                        chunkLsn = std::max(chunkLsn, journal->append(record));
+                    }
+                    if (ledger != nullptr) {
+                        ledger->refresh(*account);
+                    }
+                }
+                ++credited;
+                total += credit;
+            }
+        } catch (...) {
+            mergeChunk();
+            throw;
+        }
+        mergeChunk();
+    };
+
+    try {
+        pool.parallelFor(savings.size(), CHUNK_SIZE, processChunk);
+    } catch (...) {
+        // Interest already credited must still reach the journal
+        if (journal != nullptr && lastLsn != 0) {
+            journal->commit(lastLsn);
+        }
+        throw;
+    }
+
+    // One durable commit covers every interest posting
+    if (journal != nullptr && lastLsn != 0) {
+        journal->commit(lastLsn);
+    }
+    return report;
+}
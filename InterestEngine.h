@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include "AccountRepository.h"
+#include "Ledger.h"
+#include "Money.h"
+#include "ThreadPool.h"
+#include "Timestamp.h"
+#include "TransactionJournal.h"
+
+/**
+ * InterestReport - Totals from one InterestEngine run
+ */
+struct InterestReport {
+    size_t accountsScanned = 0;     // Savings accounts examined
+    size_t accountsCredited = 0;    // Accounts that received interest
+    Money totalInterest;
+};
+
+/**
+ * InterestEngine - Applies savings interest across the whole repository
+ *
+ * Same result as calling SavingsAccount::applyInterest on every savings
+ * account, but the accounts are processed in parallel chunks on a thread
+ * pool. Each chunk copies balances and accrual factors into contiguous
+ * arrays, computes the interest in a tight loop, then credits the accounts.
+ * All interest postings are journaled and made durable with one commit.
+ */
+class InterestEngine {
+private:
+    AccountRepository& accounts;
+    ThreadPool& pool;
+    TransactionJournal* journal;
+    Ledger* ledger;
+
+public:
+    // Accounts per chunk handed to a pool thread
+    static constexpr size_t CHUNK_SIZE = 4096;
+
+    InterestEngine(AccountRepository& accounts, ThreadPool& pool);
+
+    // Enable/disable journaling of interest postings
+    void setJournal(TransactionJournal* journal);
+
+    // Refresh credited accounts' rows in this ledger (nullptr disables)
+    void setLedger(Ledger* ledger);
+
+    // Accrue interest on every savings account up to now
+    InterestReport applyAll(const Timestamp& now);
+};
@@ -0,0 +1,254 @@
+#include "Ledger.h"
+#include "AccountFactory.h"
+#include "AccountRepository.h"
+#include "ChequingAccount.h"
+#include "SavingsAccount.h"
+#include "TFSAAccount.h"
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+using Ticks = std::chrono::system_clock::duration;
+
+std::int64_t ticksOf(const Timestamp& timestamp) {
+    return timestamp.getTimePoint().time_since_epoch().count();
+}
+
+// Column values an account contributes besides its balance
+bool rowFields(const Account& account, AccountType& type, Money& overdraftLimit,
+               double& interestRate) {
+    if (auto* savings = dynamic_cast<const SavingsAccount*>(&account)) {
+        type = dynamic_cast<const TFSAAccount*>(&account) != nullptr ? AccountType::TFSA
+                                                                     : AccountType::Savings;
+        overdraftLimit = Money();
+        interestRate = savings->getInterestRate();
+        return true;
+    }
+    if (auto* chequing = dynamic_cast<const ChequingAccount*>(&account)) {
+        type = AccountType::Chequing;
+        overdraftLimit = chequing->getOverdraftLimit();
+        interestRate = 0.0;
+        return true;
+    }
+    return false;
+}
+
+}  // namespace
+
+// Empty chunk: every row unused
+Ledger::Chunk::Chunk() {
+    std::memset(balance, 0, sizeof(balance));
+    std::memset(overdraft, 0, sizeof(overdraft));
+    std::memset(lastAccrual, 0, sizeof(lastAccrual));
+    std::memset(type, EMPTY_ROW, sizeof(type));
+    for (double& value : rate) {
+        value = 0.0;
+    }
+}
+
+// Constructor
+Ledger::Ledger() : rowCount(0) {
+}
+
+// Locate an open row (caller holds structureMutex)
+Ledger::Chunk* Ledger::rowOf(StringInterner::Handle handle, size_t& offset) const {
+    size_t index = handle / CHUNK_ROWS;
+    if (index >= chunks.size() || !chunks[index]) {
+        return nullptr;
+    }
+    offset = handle % CHUNK_ROWS;
+    Chunk* chunk = chunks[index].get();
+    return chunk->type[offset] == EMPTY_ROW ? nullptr : chunk;
+}
+
+std::mutex& Ledger::stripeFor(StringInterner::Handle handle) const {
+    return stripes[handle & (STRIPE_COUNT - 1)];
+}
+
+// Open a row
+bool Ledger::open(StringInterner::Handle handle, AccountType type, Money balance,
+                  Money overdraftLimit, double interestRate, const Timestamp& lastAccrual) {
+    std::unique_lock<std::shared_mutex> lock(structureMutex);
+
+    size_t index = handle / CHUNK_ROWS;
+    if (index >= chunks.size()) {
+        chunks.resize(index + 1);
+    }
+    if (!chunks[index]) {
+        chunks[index].reset(new Chunk());
+    }
+
+    Chunk& chunk = *chunks[index];
+    size_t offset = handle % CHUNK_ROWS;
+    if (chunk.type[offset] != EMPTY_ROW) {
+        return false;
+    }
+
+    chunk.balance[offset] = balance.getCents();
+    chunk.overdraft[offset] = type == AccountType::Chequing ? overdraftLimit.getCents() : 0;
+    chunk.rate[offset] = type != AccountType::Chequing ? interestRate : 0.0;
+    chunk.lastAccrual[offset] = ticksOf(lastAccrual);
+    chunk.type[offset] = static_cast<std::uint8_t>(type);
+    ++rowCount;
+    return true;
+}
+
+// Open a row from an account
+bool Ledger::open(const Account& account) {
+    AccountType type;
+    Money overdraftLimit;
+    double interestRate = 0.0;
+    if (!rowFields(account, type, overdraftLimit, interestRate)) {
+        return false;
+    }
+    return open(account.getAccountHandle(), type, account.getBalance(), overdraftLimit,
+                interestRate, account.getLastInterestApplied());
+}
+
+// Copy an account into its row
+bool Ledger::refresh(const Account& account) {
+    StringInterner::Handle handle = account.getAccountHandle();
+    AccountType type;
+    Money overdraftLimit;
+    double interestRate = 0.0;
+    if (!rowFields(account, type, overdraftLimit, interestRate)) {
+        return false;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(structureMutex);
+    size_t offset = 0;
+    Chunk* chunk = rowOf(handle, offset);
+    if (chunk == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> rowLock(stripeFor(handle));
+    chunk->balance[offset] = account.getBalance().getCents();
+    chunk->overdraft[offset] = overdraftLimit.getCents();
+    chunk->rate[offset] = interestRate;
+    chunk->lastAccrual[offset] = ticksOf(account.getLastInterestApplied());
+    return true;
+}
+
+// Remove a row
+bool Ledger::close(StringInterner::Handle handle) {
+    std::unique_lock<std::shared_mutex> lock(structureMutex);
+    size_t offset = 0;
+    Chunk* chunk = rowOf(handle, offset);
+    if (chunk == nullptr) {
+        return false;
+    }
+    chunk->type[offset] = EMPTY_ROW;
+    chunk->balance[offset] = 0;
+    chunk->overdraft[offset] = 0;
+    chunk->rate[offset] = 0.0;
+    --rowCount;
+    return true;
+}
+
+// Snapshot a repository
+size_t Ledger::loadFrom(AccountRepository& repository) {
+    size_t opened = 0;
+    for (Account* account : repository.getAllAccounts()) {
+        std::lock_guard<std::mutex> lock(account->getMutex());
+        if (open(*account)) {
+            ++opened;
+        }
+    }
+    return opened;
+}
+
+bool Ledger::contains(StringInterner::Handle handle) const {
+    std::shared_lock<std::shared_mutex> lock(structureMutex);
+    size_t offset = 0;
+    return rowOf(handle, offset) != nullptr;
+}
+
+size_t Ledger::getAccountCount() const {
+    std::shared_lock<std::shared_mutex> lock(structureMutex);
+    return rowCount;
+}
+
+// Row field getters
+Money Ledger::getBalance(StringInterner::Handle handle) const {
+    std::shared_lock<std::shared_mutex> lock(structureMutex);
+    size_t offset = 0;
+    Chunk* chunk = rowOf(handle, offset);
+    if (chunk == nullptr) {
+        return Money();
+    }
+    std::lock_guard<std::mutex> rowLock(stripeFor(handle));
+    return Money::fromCents(chunk->balance[offset]);
+}
+
+Money Ledger::getOverdraftLimit(StringInterner::Handle handle) const {
+    std::shared_lock<std::shared_mutex> lock(structureMutex);
+    size_t offset = 0;
+    Chunk* chunk = rowOf(handle, offset);
+    return chunk != nullptr ? Money::fromCents(chunk->overdraft[offset]) : Money();
+}
+
+double Ledger::getInterestRate(StringInterner::Handle handle) const {
+    std::shared_lock<std::shared_mutex> lock(structureMutex);
+    size_t offset = 0;
+    Chunk* chunk = rowOf(handle, offset);
+    return chunk != nullptr ? chunk->rate[offset] : 0.0;
+}
+
+AccountType Ledger::getAccountType(StringInterner::Handle handle) const {
+    std::shared_lock<std::shared_mutex> lock(structureMutex);
+    size_t offset = 0;
+    Chunk* chunk = rowOf(handle, offset);
+    return chunk != nullptr ? static_cast<AccountType>(chunk->type[offset]) : AccountType::Savings;
+}
+
+Timestamp Ledger::getLastAccrual(StringInterner::Handle handle) const {
+    std::shared_lock<std::shared_mutex> lock(structureMutex);
+    size_t offset = 0;
+    Chunk* chunk = rowOf(handle, offset);
+    if (chunk == nullptr) {
+        return Timestamp(std::chrono::system_clock::time_point());
+    }
+    std::lock_guard<std::mutex> rowLock(stripeFor(handle));
+    return Timestamp(std::chrono::system_clock::time_point(Ticks(chunk->lastAccrual[offset])));
+}
+
+// Book-wide totals
+LedgerTotals Ledger::totals() const {
+    std::unique_lock<std::shared_mutex> lock(structureMutex);
+
+    std::int64_t balanceSum = 0;
+    std::int64_t overdrawnSum = 0;
+    size_t live = 0;
+    size_t overdrawn = 0;
+
+    for (const auto& chunk : chunks) {
+        if (!chunk) {
+            continue;
+        }
+        for (size_t i = 0; i < CHUNK_ROWS; ++i) {
+            bool open = chunk->type[i] != EMPTY_ROW;
+            std::int64_t balance = chunk->balance[i];  // Zero for unused rows
+            live += open ? 1 : 0;
+            balanceSum += balance;
+            overdrawnSum += balance < 0 ? -balance : 0;
+            overdrawn += balance < 0 ? 1 : 0;
+        }
+    }
+
+    LedgerTotals result;
+    result.accounts = live;
+    result.overdrawnAccounts = overdrawn;
+    result.totalBalance = Money::fromCents(balanceSum);
+    result.totalOverdrawn = Money::fromCents(overdrawnSum);
+    return result;
+}
+
+// View one row
+LedgerAccount Ledger::view(StringInterner::Handle handle) {
+    return LedgerAccount(*this, handle);
+}
+
+std::string LedgerAccount::getAccountType() const {
+    return AccountFactory::accountTypeToString(ledger.getAccountType(handle));
+}
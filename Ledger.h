@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+#include "AccountType.h"
+#include "Money.h"
+#include "StringInterner.h"
+#include "Timestamp.h"
+
+class Account;
+class AccountRepository;
+class LedgerAccount;
+
+/**
+ * LedgerTotals - Aggregates computed by Ledger::totals
+ */
+struct LedgerTotals {
+    size_t accounts = 0;
+    size_t overdrawnAccounts = 0;
+    Money totalBalance;
+    Money totalOverdrawn;       // Sum of negative balances, as a positive amount
+};
+
+/**
+ * LedgerColumns - Read-only view of one Ledger chunk
+ * Unused rows have type EMPTY_TYPE and zero balance, limit and rate.
+ */
+struct LedgerColumns {
+    static constexpr std::uint8_t EMPTY_TYPE = 0xFF;
+
+    const std::int64_t* balance;
+    const std::int64_t* overdraft;
+    const double* rate;
+    const std::int64_t* lastAccrual;
+    const std::uint8_t* type;
+    size_t rows;
+};
+
+/**
+ * Ledger - Struct-of-arrays mirror of account state
+ *
+ * Balances, overdraft limits, interest rates, account types and last
+ * accrual times live in parallel column arrays indexed by account handle
+ * (see StringInterner), in chunks of CHUNK_ROWS rows. Whole-book reads
+ * (totals, BankAnalytics) are branch-free loops over plain arrays per
+ * chunk with no virtual calls.
+ *
+ * The Account objects stay the source of truth: money only moves through
+ * them, so every change gets its history entry and journal record, and
+ * rows are copied from accounts with open/refresh. BankSystem::setLedger
+ * keeps a ledger current as postings are made.
+ *
+ * Thread-safe: refreshing a row locks its stripe; opening and closing rows
+ * and whole-book scans take the ledger exclusively.
+ */
+class Ledger {
+public:
+    static constexpr size_t CHUNK_ROWS = 4096;
+
+private:
+    static constexpr std::uint8_t EMPTY_ROW = LedgerColumns::EMPTY_TYPE;
+    static constexpr size_t STRIPE_COUNT = 256;
+
+    struct Chunk {
+        std::int64_t balance[CHUNK_ROWS];       // Cents
+        std::int64_t overdraft[CHUNK_ROWS];     // Cents, zero unless chequing
+        double rate[CHUNK_ROWS];                // Annual rate, zero unless savings
+        std::int64_t lastAccrual[CHUNK_ROWS];   // system_clock ticks
+        std::uint8_t type[CHUNK_ROWS];          // AccountType or EMPTY_ROW
+
+        Chunk();
+    };
+
+    mutable std::shared_mutex structureMutex;
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    mutable std::array<std::mutex, STRIPE_COUNT> stripes;
+    size_t rowCount;
+
+    // Row location; nullptr if the handle has no open row
+    Chunk* rowOf(StringInterner::Handle handle, size_t& offset) const;
+
+    std::mutex& stripeFor(StringInterner::Handle handle) const;
+
+public:
+    Ledger();
+
+    Ledger(const Ledger&) = delete;
+    Ledger& operator=(const Ledger&) = delete;
+
+    // Open a row; false if the handle already has one
+    bool open(StringInterner::Handle handle, AccountType type, Money balance,
+              Money overdraftLimit, double interestRate, const Timestamp& lastAccrual);
+
+    // Open a row from an account's current state (caller holds its lock)
+    bool open(const Account& account);
+
+    // Copy an account's current state into its row; false if the account
+    // has no row (caller holds the account lock)
+    bool refresh(const Account& account);
+
+    // Remove a row
+    bool close(StringInterner::Handle handle);
+
+    // Snapshot every account of a repository; returns rows opened
+    size_t loadFrom(AccountRepository& repository);
+
+    bool contains(StringInterner::Handle handle) const;
+    size_t getAccountCount() const;
+
+    // Row fields (zero / Savings for unknown handles)
+    Money getBalance(StringInterner::Handle handle) const;
+    Money getOverdraftLimit(StringInterner::Handle handle) const;
+    double getInterestRate(StringInterner::Handle handle) const;
+    AccountType getAccountType(StringInterner::Handle handle) const;
+    Timestamp getLastAccrual(StringInterner::Handle handle) const;
+
+    // Book-wide aggregates
+    LedgerTotals totals() const;
+
+    // Call visit(const LedgerColumns&) for every chunk while holding the
+    // ledger exclusively (no row can be refreshed meanwhile)
+    template <typename F>
+    void scanChunks(F&& visit) const {
+        std::unique_lock<std::shared_mutex> lock(structureMutex);
+        for (const auto& chunk : chunks) {
+            if (chunk) {
+                visit(LedgerColumns{chunk->balance, chunk->overdraft, chunk->rate,
+                                    chunk->lastAccrual, chunk->type, CHUNK_ROWS});
+            }
+        }
+    }
+
+    // Thin Account-like view of one row
+    LedgerAccount view(StringInterner::Handle handle);
+};
+
+/**
+ * LedgerAccount - Read-only Account-style facade over one Ledger row
+ *
+ * Offers the familiar Account getters so reporting code written against
+ * accounts can run on the ledger; holds only a ledger reference and a
+ * handle.
+ */
+class LedgerAccount {
+private:
+    Ledger& ledger;
+    StringInterner::Handle handle;
+
+public:
+    LedgerAccount(Ledger& ledger, StringInterner::Handle handle)
+        : ledger(ledger), handle(handle) {}
+
+    StringInterner::Handle getAccountHandle() const { return handle; }
+    const std::string& getAccountNo() const {
+        return StringInterner::accountNumbers().view(handle);
+    }
+
+    Money getBalance() const { return ledger.getBalance(handle); }
+    Money getOverdraftLimit() const { return ledger.getOverdraftLimit(handle); }
+    double getInterestRate() const { return ledger.getInterestRate(handle); }
+    Timestamp getLastInterestApplied() const { return ledger.getLastAccrual(handle); }
+    std::string getAccountType() const;
+};
@@ -0,0 +1,149 @@
+#include "Logger.h"
+#include <chrono>
+
+// Constructor - allocate the ring and start the drain thread
+Logger::Logger()
+    : ring(new Slot[RING_CAPACITY]),
+      enqueuePos(0),
+      dequeuePos(0),
+      writtenCount(0),
+      droppedCount(0),
+      minLevel(static_cast<int>(LogLevel::Warn)),
+      sink(stderr),
+      running(true) {
+    for (size_t i = 0; i < RING_CAPACITY; ++i) {
+        ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    worker = std::thread(&Logger::drainLoop, this);
+}
+
+// Destructor - stop the thread and write whatever is left
+Logger::~Logger() {
+    running.store(false);
+    wake.notify_one();
+    if (worker.joinable()) {
+        worker.join();
+    }
+    drainOnce();
+    delete[] ring;
+}
+
+// Process-wide logger
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+void Logger::setLevel(LogLevel level) {
+    minLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+LogLevel Logger::getLevel() const {
+    return static_cast<LogLevel>(minLevel.load(std::memory_order_relaxed));
+}
+
+void Logger::setSink(std::FILE* newSink) {
+    flush();
+    sink.store(newSink != nullptr ? newSink : stderr);
+}
+
+size_t Logger::getDroppedCount() const {
+    return droppedCount.load(std::memory_order_relaxed);
+}
+
+const char* Logger::levelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace:
+            return "TRACE";
+        case LogLevel::Debug:
+            return "DEBUG";
+        case LogLevel::Info:
+            return "INFO";
+        case LogLevel::Warn:
+            return "WARN";
+        case LogLevel::Error:
+            return "ERROR";
+        default:
+            return "OFF";
+    }
+}
+
+// Claim the next slot (bounded MPMC queue, Vyukov-style sequence numbers)
+Logger::Slot* Logger::acquireSlot(size_t& position) {
+    position = enqueuePos.load(std::memory_order_relaxed);
+
+    for (;;) {
+        Slot* slot = &ring[position & (RING_CAPACITY - 1)];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) -
+                              static_cast<std::ptrdiff_t>(position);
+
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(position, position + 1,
+                                                 std::memory_order_relaxed)) {
+                return slot;
+            }
+        } else if (diff < 0) {
+            // Ring full - drop rather than block the caller
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        } else {
+            position = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// Hand a filled slot to the consumer
+void Logger::publish(Slot* slot, size_t position) {
+    slot->sequence.store(position + 1, std::memory_order_release);
+}
+
+// Write every published message to the sink
+size_t Logger::drainOnce() {
+    std::FILE* out = sink.load();
+    size_t drained = 0;
+
+    for (;;) {
+        Slot* slot = &ring[dequeuePos & (RING_CAPACITY - 1)];
+        if (slot->sequence.load(std::memory_order_acquire) != dequeuePos + 1) {
+            break;
+        }
+
+        const char* name = levelName(slot->level);
+        std::fputc('[', out);
+        std::fputs(name, out);
+        std::fputs("] ", out);
+        std::fwrite(slot->text, 1, slot->length, out);
+        std::fputc('\n', out);
+
+        slot->sequence.store(dequeuePos + RING_CAPACITY, std::memory_order_release);
+        ++dequeuePos;
+        ++drained;
+    }
+
+    if (drained > 0) {
+        std::fflush(out);
+        writtenCount.store(dequeuePos, std::memory_order_release);
+    }
+    return drained;
+}
+
+// Background drain loop
+void Logger::drainLoop() {
+    while (running.load()) {
+        if (drainOnce() == 0) {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wake.wait_for(lock, std::chrono::milliseconds(2));
+        }
+    }
+}
+
+// Wait until everything logged so far has reached the sink
+void Logger::flush() {
+    size_t target = enqueuePos.load(std::memory_order_acquire);
+
+    while (writtenCount.load(std::memory_order_acquire) < target && running.load()) {
+        wake.notify_one();
+        std::this_thread::yield();
+    }
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <atomic>
+#include <charconv>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include "Money.h"
+
+/**
+ * LogLevel enumeration
+ * Severity of a log message, lowest to highest
+ */
+enum class LogLevel : int {
+    Trace = 0,
+    Debug = 1,
+    Info = 2,
+    Warn = 3,
+    Error = 4,
+    Off = 5
+};
+
+// Messages below this level are removed at compile time
+#ifndef BANK_LOG_COMPILE_LEVEL
+#define BANK_LOG_COMPILE_LEVEL 1
+#endif
+
+/**
+ * Logger - Asynchronous structured logger
+ *
+ * Callers format their message straight into a slot of a bounded lock-free
+ * ring buffer (multi-producer, single-consumer) and return immediately; a
+ * background thread drains the ring to the sink. Nothing on the posting
+ * path blocks on terminal or file I/O. If the ring is full the message is
+ * dropped and counted rather than stalling the caller.
+ *
+ * Use the LOG_* macros: they skip argument evaluation for disabled levels
+ * and compile to nothing below BANK_LOG_COMPILE_LEVEL.
+ */
+class Logger {
+public:
+    static constexpr size_t MESSAGE_CAPACITY = 240;
+    static constexpr size_t RING_CAPACITY = 4096;  // Must be a power of two
+
+    // Fixed-size message builder used while filling a ring slot
+    class Line {
+    private:
+        char* data;
+        size_t length;
+
+        void appendRaw(const char* text, size_t size) {
+            size_t room = MESSAGE_CAPACITY - length;
+            size_t n = size < room ? size : room;
+            std::memcpy(data + length, text, n);
+            length += n;
+        }
+
+    public:
+        explicit Line(char* buffer) : data(buffer), length(0) {}
+
+        size_t size() const { return length; }
+
+        Line& operator<<(std::string_view text) {
+            appendRaw(text.data(), text.size());
+            return *this;
+        }
+        Line& operator<<(const char* text) { return *this << std::string_view(text); }
+        Line& operator<<(const std::string& text) { return *this << std::string_view(text); }
+        Line& operator<<(char c) { appendRaw(&c, 1); return *this; }
+        Line& operator<<(bool value) { return *this << (value ? "true" : "false"); }
+
+        Line& operator<<(Money amount) {
+            char buffer[Money::MAX_CHARS];
+            char* end = amount.toChars(buffer, buffer + sizeof(buffer));
+            appendRaw(buffer, static_cast<size_t>(end - buffer));
+            return *this;
+        }
+
+        template <typename T,
+                  typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+        Line& operator<<(T value) {
+            char buffer[32];
+            auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            appendRaw(buffer, static_cast<size_t>(result.ptr - buffer));
+            return *this;
+        }
+    };
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        LogLevel level;
+        std::uint16_t length;
+        char text[MESSAGE_CAPACITY];
+    };
+
+    Slot* ring;
+    std::atomic<size_t> enqueuePos;
+    size_t dequeuePos;                   // Consumer thread only
+    std::atomic<size_t> writtenCount;    // Messages handed to the sink
+    std::atomic<size_t> droppedCount;
+
+    std::atomic<int> minLevel;
+    std::atomic<std::FILE*> sink;
+
+    std::atomic<bool> running;
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::thread worker;
+
+    Logger();
+
+    // Claim a slot; returns nullptr (and counts a drop) if the ring is full
+    Slot* acquireSlot(size_t& position);
+    void publish(Slot* slot, size_t position);
+
+    // Background thread: drain the ring into the sink
+    void drainLoop();
+    size_t drainOnce();
+
+public:
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    // Process-wide logger
+    static Logger& instance();
+
+    // Runtime level filter (default: Warn)
+    void setLevel(LogLevel level);
+    LogLevel getLevel() const;
+    bool isEnabled(LogLevel level) const {
+        return static_cast<int>(level) >= minLevel.load(std::memory_order_relaxed);
+    }
+
+    // Destination for drained messages (default: stderr)
+    void setSink(std::FILE* sink);
+
+    // Format the arguments into a ring slot; never blocks on I/O
+    template <typename... Args>
+    void log(LogLevel level, const Args&... args) {
+        size_t position;
+        Slot* slot = acquireSlot(position);
+        if (slot == nullptr) {
+            return;
+        }
+
+        Line line(slot->text);
+        (void)std::initializer_list<int>{((void)(line << args), 0)...};
+        slot->level = level;
+        slot->length = static_cast<std::uint16_t>(line.size());
+        publish(slot, position);
+    }
+
+    // Block until every message logged before this call has been written
+    void flush();
+
+    // Number of messages discarded because the ring was full
+    size_t getDroppedCount() const;
+
+    static const char* levelName(LogLevel level);
+};
+
+#define BANK_LOG(level, ...)                                                  \
+    do {                                                                      \
+        if constexpr (static_cast<int>(level) >= BANK_LOG_COMPILE_LEVEL) {    \
+            Logger& bankLogger = Logger::instance();                          \
+            if (bankLogger.isEnabled(level)) {                                \
+                bankLogger.log(level, __VA_ARGS__);                           \
+            }                                                                 \
+        }                                                                     \
+    } while (0)
+
+#define LOG_TRACE(...) BANK_LOG(LogLevel::Trace, __VA_ARGS__)
+#define LOG_DEBUG(...) BANK_LOG(LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO(...) BANK_LOG(LogLevel::Info, __VA_ARGS__)
+#define LOG_WARN(...) BANK_LOG(LogLevel::Warn, __VA_ARGS__)
+#define LOG_ERROR(...) BANK_LOG(LogLevel::Error, __VA_ARGS__)
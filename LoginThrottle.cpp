@@ -0,0 +1,74 @@
+#include "LoginThrottle.h"
+#include <algorithm>
+
+// Constructor
+LoginThrottle::LoginThrottle(double ratePerSecond, double burst,
+                             std::chrono::seconds failureWindow,
+                             std::chrono::seconds lockoutPeriod)
+    : failureWindow(failureWindow), lockoutPeriod(lockoutPeriod),
+      ratePerSecond(ratePerSecond), burst(burst), tokens(burst),
+      lastRefill(Clock::now()) {
+}
+
+// Add the tokens accrued since the last refill (caller holds mutex)
+void LoginThrottle::refill(Clock::time_point now) {
+    std::chrono::duration<double> elapsed = now - lastRefill;
+    tokens = std::min(burst, tokens + elapsed.count() * ratePerSecond);
+    lastRefill = now;
+}
+
+// Check lockout and global budget
+bool LoginThrottle::tryAcquire(const std::string& userId) {
+    Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = failuresByUser.find(userId);
+    if (it != failuresByUser.end() && it->second.lockedUntil > now) {
+        return false;
+    }
+
+    refill(now);
+    if (tokens < 1.0) {
+        return false;
+    }
+    tokens -= 1.0;
+    return true;
+}
+
+// Count a failed verification
+void LoginThrottle::recordFailure(const std::string& userId) {
+    Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex);
+
+    FailureState& state = failuresByUser[userId];
+    if (state.failures == 0 || now - state.firstFailure > failureWindow) {
+        state.failures = 0;
+        state.firstFailure = now;
+    }
+
+    if (++state.failures >= MAX_FAILURES) {
+        state.lockedUntil = now + lockoutPeriod;
+        state.failures = 0;
+    }
+}
+
+// A successful login clears the user's failure history
+void LoginThrottle::recordSuccess(const std::string& userId) {
+    std::lock_guard<std::mutex> lock(mutex);
+    failuresByUser.erase(userId);
+}
+
+bool LoginThrottle::isLockedOut(const std::string& userId) const {
+    Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = failuresByUser.find(userId);
+    return it != failuresByUser.end() && it->second.lockedUntil > now;
+}
+
+void LoginThrottle::setRate(double ratePerSecond, double burst) {
+    std::lock_guard<std::mutex> lock(mutex);
+    refill(Clock::now());
+    this->ratePerSecond = ratePerSecond;
+    this->burst = burst;
+    tokens = std::min(tokens, burst);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * LoginThrottle - Caps the password-verification work attackers can cause
+ *
+ * Two independent limits are applied before a password is hashed:
+ *  - per user: after MAX_FAILURES consecutive failures within the failure
+ *    window the user is locked out for the lockout period;
+ *  - global: a token bucket bounds the number of verifications per second
+ *    across all users, so spraying many user ids cannot saturate the CPU.
+ */
+class LoginThrottle {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int MAX_FAILURES = 5;
+
+private:
+    struct FailureState {
+        int failures = 0;
+        Clock::time_point firstFailure;
+        Clock::time_point lockedUntil;
+    };
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, FailureState> failuresByUser;
+
+    std::chrono::seconds failureWindow;
+    std::chrono::seconds lockoutPeriod;
+
+    // Global token bucket
+    double ratePerSecond;
+    double burst;
+    double tokens;
+    Clock::time_point lastRefill;
+
+    void refill(Clock::time_point now);
+
+public:
+    LoginThrottle(double ratePerSecond = 20.0, double burst = 20.0,
+                  std::chrono::seconds failureWindow = std::chrono::minutes(15),
+                  std::chrono::seconds lockoutPeriod = std::chrono::minutes(15));
+
+    // May a verification for userId run now? Consumes a global token.
+    bool tryAcquire(const std::string& userId);
+
+    void recordFailure(const std::string& userId);
+    void recordSuccess(const std::string& userId);
+
+    bool isLockedOut(const std::string& userId) const;
+
+    // Change the global verification budget
+    void setRate(double ratePerSecond, double burst);
+};
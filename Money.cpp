@@ -0,0 +1,151 @@
+#include "Money.h"
+#include <cmath>
+#include <cstring>
+#include <ostream>
+#include <string_view>
+
+// Two-digit lookup table: "00" "01" ... "99"
+static const char DIGIT_PAIRS[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// Convert a floating point amount, rounding to the nearest cent
+Money Money::fromDouble(double amount) {
+    if (!std::isfinite(amount)) {
+        throw std::invalid_argument("Money amount must be finite");
+    }
+
+    double scaled = std::round(amount * CENTS_PER_UNIT);
+    // 2^63 is exactly representable; anything at or beyond it does not fit
+    if (scaled >= 9223372036854775808.0 || scaled < -9223372036854775808.0) {
+        throw std::overflow_error("Money amount out of range");
+    }
+    return Money(static_cast<std::int64_t>(scaled));
+}
+
+// Parse a decimal amount with at most two fractional digits
+bool Money::parse(const char* first, const char* last, Money& out) {
+    const char* p = first;
+    bool negative = false;
+
+    if (p != last && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    // Accumulate the magnitude in cents; the limit allows MIN_CENTS
+    const std::uint64_t limit = static_cast<std::uint64_t>(MAX_CENTS) + (negative ? 1 : 0);
+    std::uint64_t whole = 0;
+    const char* digitsStart = p;
+
+    while (p != last && static_cast<unsigned>(*p - '0') < 10) {
+        whole = whole * 10 + static_cast<unsigned>(*p - '0');
+        if (whole > limit / CENTS_PER_UNIT) {
+            return false;
+        }
+        ++p;
+    }
+    bool hasWhole = (p != digitsStart);
+
+    std::uint64_t fraction = 0;
+    int fractionDigits = 0;
+    if (p != last && *p == '.') {
+        ++p;
+        while (p != last && static_cast<unsigned>(*p - '0') < 10) {
+            if (++fractionDigits > 2) {
+                return false;
+            }
+            fraction = fraction * 10 + static_cast<unsigned>(*p - '0');
+            ++p;
+        }
+    }
+
+    if (p != last || (!hasWhole && fractionDigits == 0)) {
+        return false;
+    }
+    if (fractionDigits == 1) {
+        fraction *= 10;
+    }
+
+    std::uint64_t magnitude = whole * CENTS_PER_UNIT + fraction;
+    if (magnitude > limit) {
+        return false;
+    }
+
+    out = Money(negative ? static_cast<std::int64_t>(0 - magnitude)
+                         : static_cast<std::int64_t>(magnitude));
+    return true;
+}
+
+bool Money::parse(const std::string& text, Money& out) {
+    return parse(text.data(), text.data() + text.size(), out);
+}
+
+// Convert to floating point (display/interop only)
+double Money::toDouble() const {
+    return static_cast<double>(cents) / CENTS_PER_UNIT;
+}
+
+// Scale by a factor, rounding to the nearest cent
+Money Money::multipliedBy(double factor) const {
+    double scaled = std::round(static_cast<double>(cents) * factor);
+    if (!std::isfinite(scaled) ||
+        scaled >= 9223372036854775808.0 || scaled < -9223372036854775808.0) {
+        throw std::overflow_error("Money multiplication overflow");
+    }
+    return Money(static_cast<std::int64_t>(scaled));
+}
+
+// Format as "-1234.50", filling digits right to left two at a time
+char* Money::toChars(char* first, char* last) const {
+    char buffer[MAX_CHARS];
+    char* p = buffer + MAX_CHARS;
+
+    std::uint64_t magnitude = cents < 0 ? 0 - static_cast<std::uint64_t>(cents)
+                                        : static_cast<std::uint64_t>(cents);
+    std::uint64_t whole = magnitude / CENTS_PER_UNIT;
+    unsigned fraction = static_cast<unsigned>(magnitude % CENTS_PER_UNIT);
+
+    p -= 2;
+    std::memcpy(p, DIGIT_PAIRS + fraction * 2, 2);
+    *--p = '.';
+
+    while (whole >= 100) {
+        unsigned pair = static_cast<unsigned>(whole % 100);
+        whole /= 100;
+        p -= 2;
+        std::memcpy(p, DIGIT_PAIRS + pair * 2, 2);
+    }
+    if (whole >= 10) {
+        p -= 2;
+        std::memcpy(p, DIGIT_PAIRS + whole * 2, 2);
+    } else {
+        *--p = static_cast<char>('0' + whole);
+    }
+
+    if (cents < 0) {
+        *--p = '-';
+    }
+
+    std::size_t length = static_cast<std::size_t>(buffer + MAX_CHARS - p);
+    if (static_cast<std::size_t>(last - first) < length) {
+        return nullptr;
+    }
+    std::memcpy(first, p, length);
+    return first + length;
+}
+
+std::string Money::toString() const {
+    char buffer[MAX_CHARS];
+    char* end = toChars(buffer, buffer + MAX_CHARS);
+    return std::string(buffer, end);
+}
+
+// Stream output
+std::ostream& operator<<(std::ostream& os, Money amount) {
+    char buffer[Money::MAX_CHARS];
+    char* end = amount.toChars(buffer, buffer + Money::MAX_CHARS);
+    // string_view output keeps std::setw/std::left padding working
+    return os << std::string_view(buffer, static_cast<std::size_t>(end - buffer));
+}
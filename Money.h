@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Money - Fixed-point currency amount stored as integer minor units (cents)
+ * All arithmetic is exact and overflow-checked, so balances never drift
+ * the way repeated double additions do
+ */
+class Money {
+private:
+    std::int64_t cents;
+
+    constexpr explicit Money(std::int64_t cents) : cents(cents) {}
+
+    static constexpr std::int64_t MAX_CENTS = std::numeric_limits<std::int64_t>::max();
+    static constexpr std::int64_t MIN_CENTS = std::numeric_limits<std::int64_t>::min();
+
+public:
+    static constexpr std::int64_t CENTS_PER_UNIT = 100;
+
+    // Longest formatted value: sign + 17 integer digits + '.' + 2 decimals
+    static constexpr std::size_t MAX_CHARS = 21;
+
+    // Zero amount
+    constexpr Money() : cents(0) {}
+
+    // Factory methods
+    static constexpr Money fromCents(std::int64_t cents) {
+        return Money(cents);
+    }
+
+    static constexpr Money fromUnits(std::int64_t units) {
+        if (units > MAX_CENTS / CENTS_PER_UNIT || units < MIN_CENTS / CENTS_PER_UNIT) {
+            throw std::overflow_error("Money amount out of range");
+        }
+        return Money(units * CENTS_PER_UNIT);
+    }
+
+    // Convert a floating point amount, rounding to the nearest cent
+    static Money fromDouble(double amount);
+
+    // Parse "123", "-123.4", "123.45" (at most two decimals)
+    // Returns false on malformed input or overflow, leaving out untouched
+    static bool parse(const char* first, const char* last, Money& out);
+    static bool parse(const std::string& text, Money& out);
+
+    // Getters
+    constexpr std::int64_t getCents() const { return cents; }
+    double toDouble() const;
+
+    constexpr bool isZero() const { return cents == 0; }
+    constexpr bool isNegative() const { return cents < 0; }
+    constexpr bool isPositive() const { return cents > 0; }
+
+    // Checked arithmetic - throws std::overflow_error
+    constexpr Money operator+(Money other) const {
+        if ((other.cents > 0 && cents > MAX_CENTS - other.cents) ||
+            (other.cents < 0 && cents < MIN_CENTS - other.cents)) {
+            throw std::overflow_error("Money addition overflow");
+        }
+        return Money(cents + other.cents);
+    }
+
+    constexpr Money operator-(Money other) const {
+        if ((other.cents < 0 && cents > MAX_CENTS + other.cents) ||
+            (other.cents > 0 && cents < MIN_CENTS + other.cents)) {
+            throw std::overflow_error("Money subtraction overflow");
+        }
+        return Money(cents - other.cents);
+    }
+
+    constexpr Money operator-() const {
+        if (cents == MIN_CENTS) {
+            throw std::overflow_error("Money negation overflow");
+        }
+        return Money(-cents);
+    }
+
+    constexpr Money& operator+=(Money other) {
+        *this = *this + other;
+        return *this;
+    }
+
+    constexpr Money& operator-=(Money other) {
+        *this = *this - other;
+        return *this;
+    }
+
+    // Scale by a factor (e.g. an interest rate), rounding to the nearest cent
+    Money multipliedBy(double factor) const;
+
+    // Comparison operators
+    constexpr bool operator<(Money other) const { return cents < other.cents; }
+    constexpr bool operator>(Money other) const { return cents > other.cents; }
+    constexpr bool operator<=(Money other) const { return cents <= other.cents; }
+    constexpr bool operator>=(Money other) const { return cents >= other.cents; }
+    constexpr bool operator==(Money other) const { return cents == other.cents; }
+    constexpr bool operator!=(Money other) const { return cents != other.cents; }
+
+    // Formatting: "-1234.50"
+    // Writes into [first, last) without allocating; returns one past the last
+    // character written, or nullptr if the buffer is too small
+    char* toChars(char* first, char* last) const;
+    std::string toString() const;
+};
+
+// Stream output in the same "1234.50" form as toChars
+std::ostream& operator<<(std::ostream& os, Money amount);
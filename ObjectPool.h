@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * ObjectPool - Slab allocator for objects of a single type
+ *
+ * Memory is taken from the system in slabs holding many objects and handed
+ * out from an intrusive free list, so creating or destroying millions of
+ * accounts costs a handful of large allocations instead of millions of
+ * small ones, and objects created together sit next to each other.
+ *
+ * Once every object has been returned, a pool that grew beyond one
+ * default-sized slab releases all of its slabs (e.g. after
+ * AccountRepository::clear); a pool that never grew keeps its one slab.
+ */
+template <typename T, std::size_t SLAB_OBJECTS = 1024>
+class ObjectPool {
+private:
+    union Block {
+        Block* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+    static_assert(alignof(Block) <= alignof(std::max_align_t),
+                  "ObjectPool does not support over-aligned types");
+
+    std::mutex mutex;
+    std::vector<std::pair<Block*, std::size_t>> slabs;  // Slab start, object count
+    Block* freeList = nullptr;
+    std::size_t freeCount = 0;
+    std::size_t capacity = 0;
+
+    // Allocate a slab and thread its blocks onto the free list
+    void addSlab(std::size_t objects) {
+        Block* slab = static_cast<Block*>(::operator new(sizeof(Block) * objects));
+        slabs.emplace_back(slab, objects);
+        for (std::size_t i = objects; i-- > 0;) {
+            slab[i].next = freeList;
+            freeList = &slab[i];
+        }
+        freeCount += objects;
+        capacity += objects;
+    }
+
+    void releaseSlabs() {
+        for (const auto& slab : slabs) {
+            ::operator delete(slab.first);
+        }
+        slabs.clear();
+        freeList = nullptr;
+        freeCount = 0;
+        capacity = 0;
+    }
+
+public:
+    ObjectPool() = default;
+
+    // Slabs are only released when no object is still live
+    ~ObjectPool() {
+        if (freeCount == capacity) {
+            releaseSlabs();
+        }
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    // Memory for one T
+    void* allocate() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (freeList == nullptr) {
+            addSlab(SLAB_OBJECTS);
+        }
+        Block* block = freeList;
+        freeList = block->next;
+        --freeCount;
+        return block->storage;
+    }
+
+    // Return memory obtained from allocate()
+    void deallocate(void* ptr) {
+        std::lock_guard<std::mutex> lock(mutex);
+        Block* block = static_cast<Block*>(ptr);
+        block->next = freeList;
+        freeList = block;
+        ++freeCount;
+
+        if (freeCount == capacity && capacity > SLAB_OBJECTS) {
+            releaseSlabs();
+        }
+    }
+
+    // Make room for count more objects with a single slab (bulk load)
+    void reserve(std::size_t count) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (count > freeCount) {
+            addSlab(count - freeCount);
+        }
+    }
+
+    // Number of objects currently allocated
+    std::size_t getLiveCount() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return capacity - freeCount;
+    }
+};
+
+/**
+ * PoolAllocated - Mixin routing `new T` / `delete` through a per-type pool
+ *
+ * Inherit as `class X : public Base, public PoolAllocated<X>`. Deleting
+ * through a base pointer still reaches the pool because the base has a
+ * virtual destructor. Further-derived classes (a different size) fall back
+ * to the global heap.
+ */
+template <typename T>
+class PoolAllocated {
+public:
+    static ObjectPool<T>& pool() {
+        static ObjectPool<T> instance;
+        return instance;
+    }
+
+    static void* operator new(std::size_t size) {
+        if (size != sizeof(T)) {
+            return ::operator new(size);
+        }
+        return pool().allocate();
+    }
+
+    static void operator delete(void* ptr, std::size_t size) {
+        if (ptr == nullptr) {
+            return;
+        }
+        if (size != sizeof(T)) {
+            ::operator delete(ptr);
+            return;
+        }
+        pool().deallocate(ptr);
+    }
+};
@@ -0,0 +1,70 @@
+#include "OutputBuffer.h"
+#include <algorithm>
+
+// Constructor
+OutputBuffer::OutputBuffer(size_t capacity)
+    : data(std::max<size_t>(capacity, 64)), used(0),
+      flushThreshold(std::max<size_t>(capacity, 64)),
+      file(nullptr), ownsFile(false), failed(false) {
+}
+
+// Destructor - flushes anything pending
+OutputBuffer::~OutputBuffer() {
+    close();
+}
+
+bool OutputBuffer::open(const std::string& path) {
+    close();
+    failed = false;
+    used = 0;
+    if (path == "-") {
+        file = stdout;
+        return true;
+    }
+    file = std::fopen(path.c_str(), "wb");
+    ownsFile = (file != nullptr);
+    return file != nullptr;
+}
+
+// Make room; file-backed buffers write out first and only grow for one
+// oversized reservation
+void OutputBuffer::grow(size_t needed) {
+    if (file != nullptr) {
+        drain();
+        if (data.size() - used >= needed) {
+            return;
+        }
+    }
+    data.resize(std::max(data.size() * 2, used + needed));
+}
+
+void OutputBuffer::drain() {
+    if (used > 0 && std::fwrite(data.data(), 1, used, file) != used) {
+        failed = true;
+    }
+    used = 0;
+}
+
+bool OutputBuffer::flush() {
+    if (file == nullptr) {
+        return !failed;
+    }
+    drain();
+    if (std::fflush(file) != 0) {
+        failed = true;
+    }
+    return !failed;
+}
+
+bool OutputBuffer::close() {
+    if (file == nullptr) {
+        return !failed;
+    }
+    flush();
+    if (ownsFile && std::fclose(file) != 0) {
+        failed = true;
+    }
+    file = nullptr;
+    ownsFile = false;
+    return !failed;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * OutputBuffer - Reusable text buffer for bulk formatting
+ *
+ * Formatters append text in place: strings by copy, numbers through
+ * std::to_chars and values such as Money, Timestamp and TransactionId
+ * through their allocation-free toChars writers. Once the buffer has grown
+ * to its working size, rendering allocates nothing.
+ *
+ * A buffer is either scratch space read back with view(), or opened on a
+ * file, in which case pending text is written out in one call whenever it
+ * passes the flush threshold. Write errors are sticky and reported by
+ * flush() and close().
+ *
+ * Not thread-safe; give each thread its own buffer.
+ */
+class OutputBuffer {
+private:
+    std::vector<char> data;
+    size_t used;
+    size_t flushThreshold;          // File-backed: write out once this much is pending
+    std::FILE* file;
+    bool ownsFile;
+    bool failed;
+
+    void grow(size_t needed);
+    void drain();
+
+    void drainIfFull() {
+        if (file != nullptr && used >= flushThreshold) {
+            drain();
+        }
+    }
+
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 20;
+
+    explicit OutputBuffer(size_t capacity = DEFAULT_CAPACITY);
+    ~OutputBuffer();
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    // Write to a file ("-" = stdout); closes any previous file first
+    bool open(const std::string& path);
+
+    // Room for at least size more characters; finish with commit()
+    char* reserve(size_t size) {
+        if (data.size() - used < size) {
+            grow(size);
+        }
+        return data.data() + used;
+    }
+
+    // End of the characters written into reserve()'d space
+    void commit(char* end) {
+        used = static_cast<size_t>(end - data.data());
+        drainIfFull();
+    }
+
+    void append(std::string_view text) {
+        char* out = reserve(text.size());
+        std::memcpy(out, text.data(), text.size());
+        commit(out + text.size());
+    }
+
+    void put(char c) {
+        char* out = reserve(1);
+        *out = c;
+        commit(out + 1);
+    }
+
+    // Money, Timestamp, TransactionId: anything with MAX_CHARS and toChars
+    template <typename T>
+    void appendChars(const T& value) {
+        char* out = reserve(T::MAX_CHARS);
+        commit(value.toChars(out, out + T::MAX_CHARS));
+    }
+
+    void appendInteger(std::int64_t value) {
+        char* out = reserve(20);
+        commit(std::to_chars(out, out + 20, value).ptr);
+    }
+
+    // Text left-aligned in a field of at least width characters
+    void appendLeft(std::string_view text, size_t width) {
+        append(text);
+        appendSpaces(width > text.size() ? width - text.size() : 0);
+    }
+
+    // Text right-aligned in a field of at least width characters
+    void appendRight(std::string_view text, size_t width) {
+        appendSpaces(width > text.size() ? width - text.size() : 0);
+        append(text);
+    }
+
+    void appendSpaces(size_t count) {
+        char* out = reserve(count);
+        std::memset(out, ' ', count);
+        commit(out + count);
+    }
+
+    // Buffered text (scratch use; file-backed buffers hold only pending text)
+    std::string_view view() const { return std::string_view(data.data(), used); }
+    size_t size() const { return used; }
+    void clear() { used = 0; }
+
+    // Write out pending text; false once any write has failed
+    bool flush();
+
+    // Flush and close the file; false if any write failed
+    bool close();
+};
@@ -1,31 +1,125 @@
 #include "PasswordHasher.h"
+#include "Sha256.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstring>
 #include <random>
+#include <thread>
 #include <sstream>
 #include <iomanip>
 #include <functional>
 
-// Generate a random salt (16 characters)
-std::string PasswordHasher::generateSalt() {
-    const std::string characters =
-        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+namespace {
 
-    std::random_device rd;
-    std::mt19937 generator(rd());
-    std::uniform_int_distribution<> distribution(0, characters.size() - 1);
+const char SCHEME_PREFIX[] = "pbkdf2-sha256$";
+const std::size_t SCHEME_PREFIX_LENGTH = sizeof(SCHEME_PREFIX) - 1;
+const std::size_t SALT_BYTES = 16;
+const std::size_t KEY_BYTES = Sha256::DIGEST_SIZE;
+const char HEX_DIGITS[] = "0123456789abcdef";
 
-    std::string salt;
-    for (int i = 0; i < 16; ++i) {
-        salt += characters[distribution(generator)];
+std::atomic<std::uint32_t> currentIterations{PasswordHasher::DEFAULT_ITERATIONS};
+
+void appendHex(std::string& out, const std::uint8_t* bytes, std::size_t length) {
+    for (std::size_t i = 0; i < length; ++i) {
+        out += HEX_DIGITS[bytes[i] >> 4];
+        out += HEX_DIGITS[bytes[i] & 0x0f];
+    }
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+bool parseHex(const std::string& text, std::size_t begin, std::size_t end,
+              std::uint8_t* out, std::size_t outLength) {
+    if (end - begin != outLength * 2) {
+        return false;
+    }
+    for (std::size_t i = 0; i < outLength; ++i) {
+        int high = hexValue(text[begin + 2 * i]);
+        int low = hexValue(text[begin + 2 * i + 1]);
+        if (high < 0 || low < 0) {
+            return false;
+        }
+        out[i] = static_cast<std::uint8_t>((high << 4) | low);
+    }
+    return true;
+}
+
+// Fields of a "pbkdf2-sha256$iterations$salt$hash" string
+struct ParsedHash {
+    std::uint32_t iterations;
+    std::uint8_t salt[SALT_BYTES];
+    std::uint8_t key[KEY_BYTES];
+};
+
+bool parseHash(const std::string& storedHash, ParsedHash& parsed) {
+    if (storedHash.compare(0, SCHEME_PREFIX_LENGTH, SCHEME_PREFIX) != 0) {
+        return false;
+    }
+    std::size_t costEnd = storedHash.find('$', SCHEME_PREFIX_LENGTH);
+    if (costEnd == std::string::npos) {
+        return false;
+    }
+    std::size_t saltEnd = storedHash.find('$', costEnd + 1);
+    if (saltEnd == std::string::npos) {
+        return false;
+    }
+
+    const char* costBegin = storedHash.data() + SCHEME_PREFIX_LENGTH;
+    auto result = std::from_chars(costBegin, storedHash.data() + costEnd, parsed.iterations);
+    if (result.ec != std::errc() || result.ptr != storedHash.data() + costEnd ||
+        parsed.iterations == 0) {
+        return false;
     }
 
+    return parseHex(storedHash, costEnd + 1, saltEnd, parsed.salt, SALT_BYTES) &&
+           parseHex(storedHash, saltEnd + 1, storedHash.size(), parsed.key, KEY_BYTES);
+}
+
+// Compare without an early exit so timing does not leak the match length
+bool constantTimeEquals(const std::uint8_t* a, const std::uint8_t* b, std::size_t length) {
+    std::uint8_t difference = 0;
+    for (std::size_t i = 0; i < length; ++i) {
+        difference |= a[i] ^ b[i];
+    }
+    return difference == 0;
+}
+
+// Dedicated workers so hashing never queues behind (or delays) other
+// pool work such as interest runs
+ThreadPool& hashingPool() {
+    static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency() / 2));
+    return pool;
+}
+
+}  // namespace
+
+// Generate a random salt (16 bytes, hex encoded)
+std::string PasswordHasher::generateSalt() {
+    std::random_device rd;
+    std::uint8_t bytes[SALT_BYTES];
+    for (std::size_t i = 0; i < SALT_BYTES; i += 4) {
+        std::uint32_t value = rd();
+        std::memcpy(bytes + i, &value, 4);
+    }
+
+    std::string salt;
+    appendHex(salt, bytes, SALT_BYTES);
     return salt;
 }
 
-// Simple hash function using std::hash (for educational purposes)
-// In production, use a proper cryptographic hash like bcrypt or PBKDF2
-std::string PasswordHasher::sha256(const std::string& input) {
+// Simple hash function using std::hash (previous scheme, verification only)
+std::string PasswordHasher::legacyHash(const std::string& input) {
     // Use std::hash for simplicity
-    // Note: In production, use a proper cryptographic hash library
     std::hash<std::string> hasher;
     size_t hashValue = hasher(input);
 
@@ -33,7 +127,7 @@ std::string PasswordHasher::sha256(const std::string& input) {
     std::stringstream ss;
     ss << std::hex << std::setfill('0') << std::setw(16) << hashValue;
 
-    // Apply multiple rounds for better security
+    // Apply multiple rounds
     std::string result = ss.str();
     for (int i = 0; i < 1000; ++i) {
         hashValue = hasher(result + input);
@@ -46,31 +140,86 @@ std::string PasswordHasher::sha256(const std::string& input) {
 }
 
 // Hash a password with salt
-// Format: salt:hash
+// Format: pbkdf2-sha256$iterations$salt$hash
 std::string PasswordHasher::hash(const std::string& password) {
-    std::string salt = generateSalt();
-    std::string combined = salt + password;
-    std::string hashed = sha256(combined);
+    std::uint32_t iterations = getIterations();
+    std::string saltHex = generateSalt();
+
+    std::uint8_t salt[SALT_BYTES];
+    parseHex(saltHex, 0, saltHex.size(), salt, SALT_BYTES);
 
-    return salt + ":" + hashed;
+    std::uint8_t key[KEY_BYTES];
+    pbkdf2HmacSha256(password.data(), password.size(), salt, SALT_BYTES,
+                     iterations, key, KEY_BYTES);
+
+    std::string result(SCHEME_PREFIX);
+    result += std::to_string(iterations);
+    result += '$';
+    result += saltHex;
+    result += '$';
+    appendHex(result, key, KEY_BYTES);
+    return result;
 }
 
 // Verify a password against stored hash
 bool PasswordHasher::verify(const std::string& password, const std::string& storedHash) {
-    // Find the separator
+    ParsedHash parsed;
+    if (parseHash(storedHash, parsed)) {
+        std::uint8_t key[KEY_BYTES];
+        pbkdf2HmacSha256(password.data(), password.size(), parsed.salt, SALT_BYTES,
+                         parsed.iterations, key, KEY_BYTES);
+        return constantTimeEquals(key, parsed.key, KEY_BYTES);
+    }
+
+    // Legacy format: salt:hash
     size_t separatorPos = storedHash.find(':');
     if (separatorPos == std::string::npos) {
         return false;
     }
 
-    // Extract salt and hash
     std::string salt = storedHash.substr(0, separatorPos);
     std::string originalHash = storedHash.substr(separatorPos + 1);
+    return legacyHash(salt + password) == originalHash;
+}
+
+// Verify on the hashing pool
+std::future<bool> PasswordHasher::verifyAsync(const std::string& password,
+                                              const std::string& storedHash) {
+    return hashingPool().submit([password, storedHash]() {
+        return verify(password, storedHash);
+    });
+}
 
-    // Hash the provided password with the same salt
-    std::string combined = salt + password;
-    std::string newHash = sha256(combined);
+// Legacy or cheaper than the current cost
+bool PasswordHasher::needsRehash(const std::string& storedHash) {
+    ParsedHash parsed;
+    return !parseHash(storedHash, parsed) || parsed.iterations < getIterations();
+}
+
+void PasswordHasher::setIterations(std::uint32_t iterations) {
+    currentIterations.store(std::max(iterations, MIN_ITERATIONS), std::memory_order_relaxed);
+}
 
-    // Compare hashes
-    return newHash == originalHash;
-}
\ No newline at end of file
+std::uint32_t PasswordHasher::getIterations() {
+    return currentIterations.load(std::memory_order_relaxed);
+}
+
+// Scale the iteration count from a timed sample run
+std::uint32_t PasswordHasher::calibrate(std::chrono::milliseconds budget) {
+    const std::uint32_t sampleIterations = 10000;
+    std::uint8_t salt[SALT_BYTES] = {};
+    std::uint8_t key[KEY_BYTES];
+
+    auto start = std::chrono::steady_clock::now();
+    pbkdf2HmacSha256("calibration", 11, salt, SALT_BYTES, sampleIterations, key, KEY_BYTES);
+    double elapsed = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    double perIteration = std::max(elapsed, 0.001) / sampleIterations;
+    double fitting = static_cast<double>(budget.count()) / perIteration;
+    std::uint32_t iterations = fitting >= 4294967295.0
+        ? 4294967295u : static_cast<std::uint32_t>(fitting);
+
+    setIterations(iterations);
+    return getIterations();
+}
@@ -1,22 +1,49 @@
 #pragma once
+#include <chrono>
+#include <cstdint>
+#include <future>
 #include <string>
 
 /**
  * PasswordHasher - Handles password hashing and verification
- * Uses SHA-256-based hashing with salt for security
+ * Uses PBKDF2-HMAC-SHA256 with a random per-password salt
+ *
+ * Stored format: "pbkdf2-sha256$<iterations>$<salt hex>$<hash hex>", so the
+ * cost travels with each hash and can be raised without invalidating old
+ * ones. Hashes from the previous "salt:hash" scheme still verify; callers
+ * should replace them (see needsRehash) after a successful login.
  */
 class PasswordHasher {
 private:
     // Generate a random salt
     static std::string generateSalt();
 
-    // Compute SHA-256 hash of a string
-    static std::string sha256(const std::string& input);
+    // Pre-PBKDF2 scheme, kept only to verify existing "salt:hash" entries
+    static std::string legacyHash(const std::string& input);
 
 public:
-    // Hash a password with salt (returns salt:hash format)
+    static constexpr std::uint32_t DEFAULT_ITERATIONS = 100000;
+    static constexpr std::uint32_t MIN_ITERATIONS = 1000;
+
+    // Hash a password with salt using the current iteration count
     static std::string hash(const std::string& password);
 
-    // Verify a password against a stored hash
+    // Verify a password against a stored hash (either format)
     static bool verify(const std::string& password, const std::string& storedHash);
+
+    // Verify on the hashing worker pool so callers (e.g. posting threads)
+    // are not blocked by the key derivation
+    static std::future<bool> verifyAsync(const std::string& password,
+                                         const std::string& storedHash);
+
+    // True if storedHash is legacy or uses fewer iterations than current
+    static bool needsRehash(const std::string& storedHash);
+
+    // Cost for new hashes
+    static void setIterations(std::uint32_t iterations);
+    static std::uint32_t getIterations();
+
+    // Measure this machine and pick the largest cost whose hash time stays
+    // within the budget (never below MIN_ITERATIONS); returns the new cost
+    static std::uint32_t calibrate(std::chrono::milliseconds budget);
 };
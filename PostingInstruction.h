@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "Money.h"
+
+/**
+ * PostingKind enumeration
+ * Operations accepted by BankSystem::postBatch
+ */
+enum class PostingKind : std::uint8_t {
+    Deposit,
+    Withdraw,
+    Transfer
+};
+
+/**
+ * PostingResult enumeration
+ * Per-instruction outcome of BankSystem::postBatch
+ */
+enum class PostingResult : std::uint8_t {
+    Ok,
+    UnknownAccount,
+    InvalidAmount,
+    InsufficientFunds,
+    SameAccount,
+    AmountOutOfRange            // A resulting balance would overflow Money
+};
+
+/**
+ * PostingInstruction - One line of a bulk posting file
+ */
+struct PostingInstruction {
+    PostingKind kind;
+    std::string accountNo;      // Account debited/credited (transfer source)
+    std::string toAccountNo;    // Transfer target (unused otherwise)
+    Money amount;
+};
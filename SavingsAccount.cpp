@@ -1,8 +1,8 @@
 #include "SavingsAccount.h"
-#include <iostream>
+#include "Logger.h"
 
 SavingsAccount::SavingsAccount(const std::string& accountNo, const std::string& ownerId,
-                               double balance, double interestRate)
+                               Money balance, double interestRate)
     : Account(accountNo, ownerId, balance), interestRate(interestRate) {
 
     if (interestRate < 0) {
@@ -17,15 +17,11 @@ bool SavingsAccount::applyInterest(const Timestamp& now) {
     // Calculate time difference since last interest application
     double days = now.daysSince(lastInterestApplied);
 
-    // Apply simple daily interest
-    double interest = balance * (interestRate / 365.0) * days;
+    // Apply simple daily interest, rounded to the nearest cent
+    Money interest = balance.multipliedBy((interestRate / 365.0) * days);
 
-    if (interest > 0) {
-        balance += interest;
-        lastInterestApplied = now;
-
-        std::cout << "Applied interest: $" << interest
-                  << " (New balance: $" << balance << ")" << std::endl;
+    if (interest.isPositive()) {
+        creditInterest(interest, now);
 
         // Creates and record interest transaction
         return true;
@@ -34,6 +30,21 @@ bool SavingsAccount::applyInterest(const Timestamp& now) {
     return false;
 }
 
+void SavingsAccount::creditInterest(Money interest, const Timestamp& now) {
+    balance += interest;
+    lastInterestApplied = now;
+
+    HistoryEntry entry;
+    entry.id = TransactionIdGenerator::next();
+    entry.timeMicros = HistoryEntry::toMicros(now);
+    entry.kind = HistoryEntry::Kind::Interest;
+    entry.amount = interest;
+    entry.balanceAfter = balance;
+    recordHistory(entry);
+
+    LOG_DEBUG("Applied interest: $", interest, " (New balance: $", balance, ")");
+}
+
 std::string SavingsAccount::getAccountType() const {
     return "Savings";
 }
@@ -47,4 +58,5 @@ void SavingsAccount::setInterestRate(double rate) {
         throw std::invalid_argument("Interest rate cannot be negative");
     }
     interestRate = rate;
+    markDirty();
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * SegmentedArray - Grow-only array with stable element addresses
+ *
+ * Elements live in segments of doubling size (the first holds
+ * 2^FIRST_SEGMENT_BITS elements), so growing never moves existing elements
+ * and indexing is two shifts and a load. Readers may index concurrently
+ * with a writer growing the array; growth itself must be serialized by the
+ * owner. New elements are value-initialized.
+ */
+template <typename T, unsigned FIRST_SEGMENT_BITS = 10>
+class SegmentedArray {
+private:
+    static constexpr std::size_t FIRST_SEGMENT = std::size_t(1) << FIRST_SEGMENT_BITS;
+    static constexpr unsigned MAX_SEGMENTS = 48 - FIRST_SEGMENT_BITS;
+
+    std::atomic<T*> segments[MAX_SEGMENTS];
+    std::atomic<std::size_t> capacityValue;
+    unsigned segmentCount;  // Owner only
+
+    // Segment k covers indices [FIRST * (2^k - 1), FIRST * (2^(k+1) - 1))
+    static void locate(std::size_t index, unsigned& segment, std::size_t& offset) {
+        std::size_t biased = index + FIRST_SEGMENT;
+        unsigned top = 63u - static_cast<unsigned>(__builtin_clzll(biased));
+        segment = top - FIRST_SEGMENT_BITS;
+        offset = biased - (std::size_t(1) << top);
+    }
+
+public:
+    SegmentedArray() : capacityValue(0), segmentCount(0) {
+        for (auto& segment : segments) {
+            segment.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~SegmentedArray() {
+        for (unsigned k = 0; k < segmentCount; ++k) {
+            delete[] segments[k].load(std::memory_order_relaxed);
+        }
+    }
+
+    SegmentedArray(const SegmentedArray&) = delete;
+    SegmentedArray& operator=(const SegmentedArray&) = delete;
+
+    // Element access; index must be below capacity()
+    T& operator[](std::size_t index) {
+        unsigned segment;
+        std::size_t offset;
+        locate(index, segment, offset);
+        return segments[segment].load(std::memory_order_acquire)[offset];
+    }
+
+    const T& operator[](std::size_t index) const {
+        unsigned segment;
+        std::size_t offset;
+        locate(index, segment, offset);
+        return segments[segment].load(std::memory_order_acquire)[offset];
+    }
+
+    // Make indices [0, count) valid
+    void reserve(std::size_t count) {
+        while (capacityValue.load(std::memory_order_relaxed) < count) {
+            std::size_t size = FIRST_SEGMENT << segmentCount;
+            segments[segmentCount].store(new T[size](), std::memory_order_release);
+            ++segmentCount;
+            capacityValue.store(FIRST_SEGMENT * ((std::size_t(1) << segmentCount) - 1),
+                                std::memory_order_release);
+        }
+    }
+
+    std::size_t capacity() const {
+        return capacityValue.load(std::memory_order_acquire);
+    }
+};
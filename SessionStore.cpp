@@ -0,0 +1,126 @@
+#include "SessionStore.h"
+#include <functional>
+#include <mutex>
+#include <random>
+
+// Constructor
+SessionStore::SessionStore(std::chrono::seconds ttl) : ttl(ttl) {
+}
+
+// Select shard by hashing the token
+SessionStore::Shard& SessionStore::shardFor(const std::string& token) {
+    return shards[std::hash<std::string>{}(token) & (SHARD_COUNT - 1)];
+}
+
+// Random token from the OS entropy source
+std::string SessionStore::generateToken() {
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    std::random_device rd;
+
+    std::string token;
+    token.reserve(32);
+    for (int i = 0; i < 4; ++i) {
+        std::uint32_t value = rd();
+        for (int shift = 28; shift >= 0; shift -= 4) {
+            token += HEX_DIGITS[(value >> shift) & 0xf];
+        }
+    }
+    return token;
+}
+
+// Start a session
+std::string SessionStore::create(const std::string& userId) {
+    Session session{userId, Clock::now() + ttl.load(std::memory_order_relaxed)};
+
+    for (;;) {
+        std::string token = generateToken();
+        Shard& shard = shardFor(token);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        if (shard.sessions.emplace(token, session).second) {
+            return token;
+        }
+    }
+}
+
+// Resolve a token to its user
+std::optional<std::string> SessionStore::lookup(const std::string& token) {
+    Shard& shard = shardFor(token);
+    Clock::time_point now = Clock::now();
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.sessions.find(token);
+        if (it == shard.sessions.end()) {
+            return std::nullopt;
+        }
+        if (it->second.expiresAt > now) {
+            return it->second.userId;
+        }
+    }
+
+    // Expired: remove it (re-check, another thread may have raced us)
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.sessions.find(token);
+    if (it != shard.sessions.end() && it->second.expiresAt <= now) {
+        shard.sessions.erase(it);
+    }
+    return std::nullopt;
+}
+
+// End one session
+bool SessionStore::revoke(const std::string& token) {
+    Shard& shard = shardFor(token);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.sessions.erase(token) > 0;
+}
+
+// End every session of a user
+size_t SessionStore::revokeUser(const std::string& userId) {
+    size_t removed = 0;
+    for (Shard& shard : shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        for (auto it = shard.sessions.begin(); it != shard.sessions.end();) {
+            if (it->second.userId == userId) {
+                it = shard.sessions.erase(it);
+                ++removed;
+            } else {
+                ++it;
+            }
+        }
+    }
+    return removed;
+}
+
+// Drop expired sessions
+size_t SessionStore::purgeExpired() {
+    Clock::time_point now = Clock::now();
+    size_t removed = 0;
+    for (Shard& shard : shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        for (auto it = shard.sessions.begin(); it != shard.sessions.end();) {
+            if (it->second.expiresAt <= now) {
+                it = shard.sessions.erase(it);
+                ++removed;
+            } else {
+                ++it;
+            }
+        }
+    }
+    return removed;
+}
+
+void SessionStore::setTtl(std::chrono::seconds ttl) {
+    this->ttl.store(ttl, std::memory_order_relaxed);
+}
+
+std::chrono::seconds SessionStore::getTtl() const {
+    return ttl.load(std::memory_order_relaxed);
+}
+
+size_t SessionStore::getSessionCount() const {
+    size_t count = 0;
+    for (const Shard& shard : shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        count += shard.sessions.size();
+    }
+    return count;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * SessionStore - Concurrent table of login sessions
+ *
+ * A successful password check issues an opaque random token; later
+ * requests present the token and are authenticated by a hash lookup
+ * instead of re-running the password KDF. Sessions expire a fixed TTL
+ * after they were created. Like AccountRepository, the table is sharded
+ * with a reader/writer lock per shard.
+ */
+class SessionStore {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    static constexpr size_t SHARD_COUNT = 16;
+
+    struct Session {
+        std::string userId;
+        Clock::time_point expiresAt;
+    };
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string, Session> sessions;
+    };
+
+    std::array<Shard, SHARD_COUNT> shards;
+    std::atomic<std::chrono::seconds> ttl;   // Read by create() on any thread
+
+    Shard& shardFor(const std::string& token);
+
+    // 128 random bits as 32 hex characters
+    static std::string generateToken();
+
+public:
+    explicit SessionStore(std::chrono::seconds ttl = std::chrono::minutes(30));
+
+    SessionStore(const SessionStore&) = delete;
+    SessionStore& operator=(const SessionStore&) = delete;
+
+    // Start a session for userId and return its token
+    std::string create(const std::string& userId);
+
+    // User id of a live session; empty if the token is unknown or expired
+    // (an expired session is removed)
+    std::optional<std::string> lookup(const std::string& token);
+
+    // End one session / every session of a user
+    bool revoke(const std::string& token);
+    size_t revokeUser(const std::string& userId);
+
+    // Drop all expired sessions; returns how many were removed
+    size_t purgeExpired();
+
+    // Lifetime of sessions created from now on
+    void setTtl(std::chrono::seconds ttl);
+    std::chrono::seconds getTtl() const;
+
+    size_t getSessionCount() const;
+};
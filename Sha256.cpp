@@ -0,0 +1,214 @@
+#include "Sha256.h"
+#include <cstring>
+
+namespace {
+
+const std::uint32_t ROUND_CONSTANTS[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+inline std::uint32_t rotr(std::uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+inline std::uint32_t loadBigEndian(const std::uint8_t* p) {
+    return (static_cast<std::uint32_t>(p[0]) << 24) | (static_cast<std::uint32_t>(p[1]) << 16) |
+           (static_cast<std::uint32_t>(p[2]) << 8) | static_cast<std::uint32_t>(p[3]);
+}
+
+inline void storeBigEndian(std::uint8_t* p, std::uint32_t value) {
+    p[0] = static_cast<std::uint8_t>(value >> 24);
+    p[1] = static_cast<std::uint8_t>(value >> 16);
+    p[2] = static_cast<std::uint8_t>(value >> 8);
+    p[3] = static_cast<std::uint8_t>(value);
+}
+
+}  // namespace
+
+// ===== Sha256 =====
+
+Sha256::Sha256()
+    : state{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+            0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19},
+      totalLength(0), buffer{}, bufferLength(0) {
+}
+
+void Sha256::compress(const std::uint8_t* block) {
+    std::uint32_t w[64];
+    for (int i = 0; i < 16; ++i) {
+        w[i] = loadBigEndian(block + i * 4);
+    }
+    for (int i = 16; i < 64; ++i) {
+        std::uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        std::uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    std::uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    std::uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+    for (int i = 0; i < 64; ++i) {
+        std::uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+        std::uint32_t choice = (e & f) ^ (~e & g);
+        std::uint32_t temp1 = h + s1 + choice + ROUND_CONSTANTS[i] + w[i];
+        std::uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+        std::uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+        std::uint32_t temp2 = s0 + majority;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + temp1;
+        d = c;
+        c = b;
+        b = a;
+        a = temp1 + temp2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+void Sha256::update(const void* data, std::size_t length) {
+    const std::uint8_t* bytes = static_cast<const std::uint8_t*>(data);
+    totalLength += length;
+
+    if (bufferLength > 0) {
+        std::size_t take = BLOCK_SIZE - bufferLength;
+        if (take > length) {
+            take = length;
+        }
+        std::memcpy(buffer + bufferLength, bytes, take);
+        bufferLength += take;
+        bytes += take;
+        length -= take;
+        if (bufferLength < BLOCK_SIZE) {
+            return;
+        }
+        compress(buffer);
+        bufferLength = 0;
+    }
+
+    while (length >= BLOCK_SIZE) {
+        compress(bytes);
+        bytes += BLOCK_SIZE;
+        length -= BLOCK_SIZE;
+    }
+
+    std::memcpy(buffer, bytes, length);
+    bufferLength = length;
+}
+
+void Sha256::finish(std::uint8_t digest[DIGEST_SIZE]) {
+    std::uint64_t bitLength = totalLength * 8;
+
+    // Padding: 0x80, zeros, then the 64-bit big-endian message length
+    buffer[bufferLength++] = 0x80;
+    if (bufferLength > BLOCK_SIZE - 8) {
+        std::memset(buffer + bufferLength, 0, BLOCK_SIZE - bufferLength);
+        compress(buffer);
+        bufferLength = 0;
+    }
+    std::memset(buffer + bufferLength, 0, BLOCK_SIZE - 8 - bufferLength);
+    storeBigEndian(buffer + 56, static_cast<std::uint32_t>(bitLength >> 32));
+    storeBigEndian(buffer + 60, static_cast<std::uint32_t>(bitLength));
+    compress(buffer);
+
+    for (int i = 0; i < 8; ++i) {
+        storeBigEndian(digest + i * 4, state[i]);
+    }
+}
+
+void Sha256::hash(const void* data, std::size_t length, std::uint8_t digest[DIGEST_SIZE]) {
+    Sha256 context;
+    context.update(data, length);
+    context.finish(digest);
+}
+
+// ===== HmacSha256 =====
+
+HmacSha256::HmacSha256(const void* key, std::size_t keyLength) {
+    std::uint8_t block[Sha256::BLOCK_SIZE] = {};
+    if (keyLength > Sha256::BLOCK_SIZE) {
+        Sha256::hash(key, keyLength, block);
+    } else {
+        std::memcpy(block, key, keyLength);
+    }
+
+    std::uint8_t pad[Sha256::BLOCK_SIZE];
+    for (std::size_t i = 0; i < Sha256::BLOCK_SIZE; ++i) {
+        pad[i] = block[i] ^ 0x36;
+    }
+    innerStart.update(pad, Sha256::BLOCK_SIZE);
+
+    for (std::size_t i = 0; i < Sha256::BLOCK_SIZE; ++i) {
+        pad[i] = block[i] ^ 0x5c;
+    }
+    outerStart.update(pad, Sha256::BLOCK_SIZE);
+}
+
+void HmacSha256::mac(const void* message, std::size_t length,
+                     std::uint8_t out[Sha256::DIGEST_SIZE]) const {
+    mac(message, length, nullptr, 0, out);
+}
+
+void HmacSha256::mac(const void* first, std::size_t firstLength,
+                     const void* second, std::size_t secondLength,
+                     std::uint8_t out[Sha256::DIGEST_SIZE]) const {
+    std::uint8_t innerDigest[Sha256::DIGEST_SIZE];
+
+    Sha256 inner = innerStart;
+    inner.update(first, firstLength);
+    if (secondLength > 0) {
+        inner.update(second, secondLength);
+    }
+    inner.finish(innerDigest);
+
+    Sha256 outer = outerStart;
+    outer.update(innerDigest, sizeof(innerDigest));
+    outer.finish(out);
+}
+
+// ===== PBKDF2 =====
+
+void pbkdf2HmacSha256(const void* password, std::size_t passwordLength,
+                      const void* salt, std::size_t saltLength,
+                      std::uint32_t iterations, std::uint8_t* out, std::size_t outLength) {
+    HmacSha256 prf(password, passwordLength);
+
+    for (std::uint32_t blockIndex = 1; outLength > 0; ++blockIndex) {
+        // U1 = PRF(password, salt || INT(blockIndex)), Un = PRF(password, Un-1)
+        std::uint8_t indexBytes[4];
+        storeBigEndian(indexBytes, blockIndex);
+
+        std::uint8_t u[Sha256::DIGEST_SIZE];
+        std::uint8_t t[Sha256::DIGEST_SIZE];
+        prf.mac(salt, saltLength, indexBytes, sizeof(indexBytes), u);
+        std::memcpy(t, u, sizeof(t));
+
+        for (std::uint32_t i = 1; i < iterations; ++i) {
+            prf.mac(u, sizeof(u), u);
+            for (std::size_t j = 0; j < Sha256::DIGEST_SIZE; ++j) {
+                t[j] ^= u[j];
+            }
+        }
+
+        std::size_t take = outLength < sizeof(t) ? outLength : sizeof(t);
+        std::memcpy(out, t, take);
+        out += take;
+        outLength -= take;
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Sha256 - SHA-256 message digest (FIPS 180-4)
+ *
+ * Incremental: update() any number of times, then finish(). The context is
+ * a plain value type, so a partially-hashed state (e.g. an HMAC key block)
+ * can be copied and reused without rehashing.
+ */
+class Sha256 {
+public:
+    static constexpr std::size_t DIGEST_SIZE = 32;
+    static constexpr std::size_t BLOCK_SIZE = 64;
+
+private:
+    std::uint32_t state[8];
+    std::uint64_t totalLength;              // Bytes hashed so far
+    std::uint8_t buffer[BLOCK_SIZE];
+    std::size_t bufferLength;
+
+    void compress(const std::uint8_t* block);
+
+public:
+    Sha256();
+
+    void update(const void* data, std::size_t length);
+    void finish(std::uint8_t digest[DIGEST_SIZE]);
+
+    // One-shot digest
+    static void hash(const void* data, std::size_t length, std::uint8_t digest[DIGEST_SIZE]);
+};
+
+/**
+ * HmacSha256 - HMAC-SHA256 (RFC 2104) with the keyed pads hashed once
+ *
+ * The inner and outer states are computed in the constructor, so each
+ * mac() costs two compressions for short messages and never allocates.
+ */
+class HmacSha256 {
+private:
+    Sha256 innerStart;
+    Sha256 outerStart;
+
+public:
+    HmacSha256(const void* key, std::size_t keyLength);
+
+    void mac(const void* message, std::size_t length,
+             std::uint8_t out[Sha256::DIGEST_SIZE]) const;
+
+    // MAC of the concatenation first || second
+    void mac(const void* first, std::size_t firstLength,
+             const void* second, std::size_t secondLength,
+             std::uint8_t out[Sha256::DIGEST_SIZE]) const;
+};
+
+// PBKDF2-HMAC-SHA256 (RFC 8018) deriving outLength bytes
+void pbkdf2HmacSha256(const void* password, std::size_t passwordLength,
+                      const void* salt, std::size_t saltLength,
+                      std::uint32_t iterations, std::uint8_t* out, std::size_t outLength);
@@ -0,0 +1,194 @@
+#include "StatementGenerator.h"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// Column widths of the posting lines
+static const size_t DATE_WIDTH = 21;
+static const size_t KIND_WIDTH = 13;
+static const size_t AMOUNT_WIDTH = 14;
+
+// Scratch space per chunk of the combined stream; grows if a chunk needs more
+static const size_t CHUNK_BUFFER_SIZE = 64 * 1024;
+
+// Write buffer per statement file
+static const size_t FILE_BUFFER_SIZE = 64 * 1024;
+
+// Effect of an entry on the balance
+static Money signedAmount(const HistoryEntry& entry) {
+    switch (entry.kind) {
+        case HistoryEntry::Kind::Withdraw:
+        case HistoryEntry::Kind::TransferOut:
+            return -entry.amount;
+        default:
+            return entry.amount;
+    }
+}
+
+static void appendMoneyRight(OutputBuffer& out, Money amount, size_t width) {
+    char buffer[Money::MAX_CHARS];
+    char* end = amount.toChars(buffer, buffer + sizeof(buffer));
+    out.appendRight(std::string_view(buffer, static_cast<size_t>(end - buffer)), width);
+}
+
+// Account numbers become file names; keep them to a safe character set
+static std::string statementFileName(const std::string& directory, const std::string& accountNo) {
+    std::string path = directory;
+    if (!path.empty() && path.back() != '/') {
+        path += '/';
+    }
+    for (char c : accountNo) {
+        bool safe = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+                    (c >= '0' && c <= '9') || c == '-' || c == '_' || c == '.';
+        path += safe ? c : '_';
+    }
+    path += ".txt";
+    return path;
+}
+
+// Constructor
+StatementGenerator::StatementGenerator(const BankSystem& bank, ThreadPool& pool)
+    : bank(bank), pool(pool) {
+}
+
+// Render one statement
+size_t StatementGenerator::render(const Account& account, const Timestamp& from,
+                                  const Timestamp& to, OutputBuffer& out) const {
+    std::vector<HistoryEntry> entries = bank.historyRange(account.getAccountNo(), from, to);
+
+    out.append("Statement for ");
+    out.append(account.getAccountNo());
+    out.append(" (");
+    out.append(account.getAccountType());
+    out.append(")\nOwner: ");
+    out.append(account.getOwnerId());
+    out.append("\nPeriod: ");
+    out.appendChars(from);
+    out.append(" to ");
+    out.appendChars(to);
+    out.put('\n');
+
+    if (entries.empty()) {
+        out.append("No postings in this period.\n\n");
+        return 0;
+    }
+
+    out.appendLeft("Date", DATE_WIDTH);
+    out.appendLeft("Type", KIND_WIDTH);
+    out.appendRight("Amount", AMOUNT_WIDTH);
+    out.appendRight("Balance", AMOUNT_WIDTH);
+    out.append("  Counterparty\n");
+
+    for (const HistoryEntry& entry : entries) {
+        out.appendChars(entry.getTimestamp());
+        out.appendSpaces(DATE_WIDTH - Timestamp::MAX_CHARS);
+        out.appendLeft(HistoryEntry::kindName(entry.kind), KIND_WIDTH);
+        appendMoneyRight(out, signedAmount(entry), AMOUNT_WIDTH);
+        appendMoneyRight(out, entry.balanceAfter, AMOUNT_WIDTH);
+        const std::string& counterparty = entry.getCounterpartyNo();
+        if (!counterparty.empty()) {
+            out.append("  ");
+            out.append(counterparty);
+        }
+        out.put('\n');
+    }
+
+    out.append("Opening balance: ");
+    out.appendChars(entries.front().balanceAfter - signedAmount(entries.front()));
+    out.append("  Closing balance: ");
+    out.appendChars(entries.back().balanceAfter);
+    out.append("  Postings: ");
+    out.appendInteger(static_cast<std::int64_t>(entries.size()));
+    out.append("\n\n");
+    return entries.size();
+}
+
+// One stream in account order: render a wave of chunks, then write it
+StatementReport StatementGenerator::writeCombined(const Timestamp& from, const Timestamp& to,
+                                                  const std::string& path) {
+    StatementReport report;
+    std::vector<Account*> accounts = bank.getAllAccounts();
+
+    OutputBuffer out;
+    if (!out.open(path)) {
+        std::cerr << "Cannot open statement output: " << path << std::endl;
+        report.failed = accounts.size();
+        return report;
+    }
+
+    size_t chunkCount = (accounts.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    size_t waveChunks = std::max<size_t>(1, pool.getThreadCount() * 8);
+    std::vector<std::unique_ptr<OutputBuffer>> buffers(std::min(waveChunks, chunkCount));
+    for (auto& buffer : buffers) {
+        buffer = std::make_unique<OutputBuffer>(CHUNK_BUFFER_SIZE);
+    }
+    std::atomic<size_t> postings{0};
+
+    for (size_t waveStart = 0; waveStart < chunkCount; waveStart += waveChunks) {
+        size_t waveSize = std::min(waveChunks, chunkCount - waveStart);
+        pool.parallelForDynamic(waveSize, 1, [&](size_t begin, size_t end) {
+            for (size_t chunk = begin; chunk < end; ++chunk) {
+                OutputBuffer& buffer = *buffers[chunk];
+                buffer.clear();
+                size_t first = (waveStart + chunk) * CHUNK_SIZE;
+                size_t last = std::min(accounts.size(), first + CHUNK_SIZE);
+                size_t listed = 0;
+                for (size_t i = first; i < last; ++i) {
+                    listed += render(*accounts[i], from, to, buffer);
+                }
+                postings += listed;
+            }
+        });
+
+        for (size_t chunk = 0; chunk < waveSize; ++chunk) {
+            out.append(buffers[chunk]->view());
+        }
+    }
+
+    if (!out.close()) {
+        std::cerr << "Write failed: " << path << std::endl;
+        report.failed = accounts.size();
+        return report;
+    }
+    report.statements = accounts.size();
+    report.postings = postings;
+    return report;
+}
+
+// One file per account, written straight from a per-chunk buffer
+StatementReport StatementGenerator::writePerAccount(const Timestamp& from, const Timestamp& to,
+                                                    const std::string& directory) {
+    StatementReport report;
+    std::vector<Account*> accounts = bank.getAllAccounts();
+    std::atomic<size_t> written{0};
+    std::atomic<size_t> postings{0};
+    std::atomic<size_t> failed{0};
+
+    pool.parallelForDynamic(accounts.size(), CHUNK_SIZE, [&](size_t begin, size_t end) {
+        OutputBuffer out(FILE_BUFFER_SIZE);
+        for (size_t i = begin; i < end; ++i) {
+            const Account& account = *accounts[i];
+            std::string path = statementFileName(directory, account.getAccountNo());
+            if (!out.open(path)) {
+                std::cerr << "Cannot open statement output: " << path << std::endl;
+                ++failed;
+                continue;
+            }
+            size_t listed = render(account, from, to, out);
+            if (out.close()) {
+                ++written;
+                postings += listed;
+            } else {
+                std::cerr << "Write failed: " << path << std::endl;
+                ++failed;
+            }
+        }
+    });
+
+    report.statements = written;
+    report.postings = postings;
+    report.failed = failed;
+    return report;
+}
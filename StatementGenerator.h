@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include "Account.h"
+#include "BankSystem.h"
+#include "OutputBuffer.h"
+#include "ThreadPool.h"
+#include "Timestamp.h"
+
+/**
+ * StatementReport - Totals from one StatementGenerator run
+ */
+struct StatementReport {
+    size_t statements = 0;          // Statements written
+    size_t postings = 0;            // History entries listed across them
+    size_t failed = 0;              // Accounts whose statement could not be written
+};
+
+/**
+ * StatementGenerator - Per-account statements for the whole bank
+ *
+ * Each statement lists an account's postings in [from, to), fetched with
+ * BankSystem::historyRange (a binary search over the saved history), and
+ * is rendered into an OutputBuffer with no per-line allocation.
+ *
+ * Accounts are spread over a thread pool in small chunks claimed on
+ * demand, since history length - and so statement cost - varies widely
+ * between accounts. Output is either one file per account or a single
+ * stream with the statements in account order; the single stream is
+ * rendered a wave of chunks at a time, so memory stays bounded by the
+ * wave rather than by the size of the bank.
+ */
+class StatementGenerator {
+private:
+    const BankSystem& bank;
+    ThreadPool& pool;
+
+public:
+    // Accounts per chunk handed to a pool thread
+    static constexpr size_t CHUNK_SIZE = 16;
+
+    StatementGenerator(const BankSystem& bank, ThreadPool& pool);
+
+    // All statements, in account order, to one file ("-" = stdout)
+    StatementReport writeCombined(const Timestamp& from, const Timestamp& to,
+                                  const std::string& path);
+
+    // One file per account: <directory>/<account number>.txt
+    StatementReport writePerAccount(const Timestamp& from, const Timestamp& to,
+                                    const std::string& directory);
+
+    // Append one account's statement to out; returns the postings listed
+    size_t render(const Account& account, const Timestamp& from, const Timestamp& to,
+                  OutputBuffer& out) const;
+};
@@ -0,0 +1,74 @@
+#include "StringInterner.h"
+#include <functional>
+#include <stdexcept>
+
+// Constructor
+StringInterner::StringInterner() : count(0) {
+}
+
+// Process-wide account number table
+StringInterner& StringInterner::accountNumbers() {
+    static StringInterner instance;
+    return instance;
+}
+
+// Process-wide owner id table
+StringInterner& StringInterner::ownerIds() {
+    static StringInterner instance;
+    return instance;
+}
+
+// Select shard by hashing the text
+StringInterner::Shard& StringInterner::shardFor(std::string_view text) {
+    return shards[std::hash<std::string_view>{}(text) & (SHARD_COUNT - 1)];
+}
+
+const StringInterner::Shard& StringInterner::shardFor(std::string_view text) const {
+    return shards[std::hash<std::string_view>{}(text) & (SHARD_COUNT - 1)];
+}
+
+// Intern a string
+StringInterner::Handle StringInterner::intern(std::string_view text) {
+    Shard& shard = shardFor(text);
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.handles.find(text);
+        if (it != shard.handles.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.handles.find(text);
+    if (it != shard.handles.end()) {
+        return it->second;  // Interned by another thread meanwhile
+    }
+
+    Handle handle;
+    {
+        std::lock_guard<std::mutex> appendLock(appendMutex);
+        handle = count.load(std::memory_order_relaxed);
+        if (handle == INVALID_HANDLE) {
+            throw std::length_error("StringInterner: handle space exhausted");
+        }
+        strings.reserve(static_cast<size_t>(handle) + 1);
+        strings[handle].assign(text.data(), text.size());
+        count.store(handle + 1, std::memory_order_release);
+    }
+
+    shard.handles.emplace(std::string_view(strings[handle]), handle);
+    return handle;
+}
+
+// Look up without interning
+StringInterner::Handle StringInterner::find(std::string_view text) const {
+    const Shard& shard = shardFor(text);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.handles.find(text);
+    return it != shard.handles.end() ? it->second : INVALID_HANDLE;
+}
+
+// Number of interned strings
+size_t StringInterner::size() const {
+    return count.load(std::memory_order_acquire);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "SegmentedArray.h"
+
+/**
+ * StringInterner - Maps identifier strings to dense 32-bit handles
+ *
+ * Account numbers and owner ids are interned once where they enter the
+ * system; accounts, indexes and transactions then carry 4-byte handles and
+ * hand out `const std::string&` views of the single stored copy instead of
+ * copying strings around. Handles are assigned consecutively from zero, so
+ * they can index arrays directly.
+ *
+ * Interned strings are never released (account numbers are not reused).
+ * view() is lock-free; find/intern take a per-shard reader/writer lock.
+ */
+class StringInterner {
+public:
+    using Handle = std::uint32_t;
+    static constexpr Handle INVALID_HANDLE = 0xFFFFFFFFu;
+
+private:
+    static constexpr size_t SHARD_COUNT = 16;
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        // Keys view the stored strings
+        std::unordered_map<std::string_view, Handle> handles;
+    };
+
+    std::array<Shard, SHARD_COUNT> shards;
+
+    std::mutex appendMutex;
+    SegmentedArray<std::string> strings;
+    std::atomic<Handle> count;
+
+    Shard& shardFor(std::string_view text);
+    const Shard& shardFor(std::string_view text) const;
+
+public:
+    StringInterner();
+
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    // Process-wide tables
+    static StringInterner& accountNumbers();
+    static StringInterner& ownerIds();
+
+    // Handle for text, assigning the next one if it is new
+    Handle intern(std::string_view text);
+
+    // Handle for text, or INVALID_HANDLE if it was never interned
+    Handle find(std::string_view text) const;
+
+    // Stored string for a handle returned by intern()
+    const std::string& view(Handle handle) const {
+        return strings[handle];
+    }
+
+    // Number of interned strings (handles are below this)
+    size_t size() const;
+};
@@ -0,0 +1,11 @@
+#include "TFSAAccount.h"
+
+// Constructor
+TFSAAccount::TFSAAccount(const std::string& accountNo, const std::string& ownerId,
+                         Money balance, double interestRate)
+    : SavingsAccount(accountNo, ownerId, balance, interestRate) {
+}
+
+std::string TFSAAccount::getAccountType() const {
+    return "TFSA";
+}
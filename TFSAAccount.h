@@ -0,0 +1,16 @@
+#pragma once
+#include "SavingsAccount.h"
+
+/**
+ * Tax-Free Savings Account
+ * Earns interest and has no overdraft, exactly like a savings account;
+ * only the account type differs. Allocated from the SavingsAccount pool
+ * (same object size).
+ */
+class TFSAAccount : public SavingsAccount {
+public:
+    TFSAAccount(const std::string& accountNo, const std::string& ownerId,
+                Money balance, double interestRate = 0.02);
+
+    std::string getAccountType() const override;
+};
@@ -0,0 +1,146 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+// Constructor - start the workers
+ThreadPool::ThreadPool(size_t threadCount) : stopping(false) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+// Destructor - drain the queue and join
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+// Process-wide pool
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+size_t ThreadPool::getThreadCount() const {
+    return workers.size();
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    available.notify_one();
+}
+
+void ThreadPool::workerLoop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+// Split [0, count) into chunks claimed by helpers and the caller
+void ThreadPool::parallelFor(size_t count, size_t minChunk,
+                             const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+    minChunk = std::max<size_t>(minChunk, 1);
+
+    // A few chunks per thread evens out uneven chunk costs
+    size_t chunkCount = std::min((count + minChunk - 1) / minChunk, workers.size() * 4);
+    chunkCount = std::max<size_t>(chunkCount, 1);
+    size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    runChunks(count, chunkSize, body);
+}
+
+// Hand out fixed-size chunks on demand
+void ThreadPool::parallelForDynamic(size_t count, size_t chunkSize,
+                                    const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+    runChunks(count, std::max<size_t>(chunkSize, 1), body);
+}
+
+// Run [0, count) in chunkSize pieces on the caller plus idle workers
+void ThreadPool::runChunks(size_t count, size_t chunkSize,
+                           const std::function<void(size_t, size_t)>& body) {
+    size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+    if (chunkCount == 1) {
+        body(0, count);
+        return;
+    }
+
+    struct State {
+        std::atomic<size_t> nextChunk{0};
+        size_t finishedChunks = 0;
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+    auto state = std::make_shared<State>();
+    const auto* bodyPtr = &body;
+
+    // Helpers that start after every chunk is claimed touch only the state,
+    // never body, so they may safely outlive this call
+    auto runChunks = [state, bodyPtr, count, chunkSize, chunkCount]() {
+        for (;;) {
+            size_t chunk = state->nextChunk.fetch_add(1);
+            if (chunk >= chunkCount) {
+                return;
+            }
+            size_t begin = chunk * chunkSize;
+            size_t end = std::min(count, begin + chunkSize);
+
+            std::exception_ptr error;
+            try {
+                (*bodyPtr)(begin, end);
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (error && !state->error) {
+                state->error = error;
+            }
+            if (++state->finishedChunks == chunkCount) {
+                state->done.notify_all();
+            }
+        }
+    };
+
+    size_t helpers = std::min(workers.size(), chunkCount - 1);
+    for (size_t i = 0; i < helpers; ++i) {
+        enqueue(runChunks);
+    }
+    runChunks();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&]() { return state->finishedChunks == chunkCount; });
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
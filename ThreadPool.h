@@ -0,0 +1,72 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * ThreadPool - Fixed set of worker threads running queued tasks
+ *
+ * submit() queues a single task and returns a future for its result.
+ * parallelFor() splits an index range into chunks that the workers and the
+ * calling thread claim from a shared counter, so it is safe to call from
+ * inside a pool task (the caller keeps working instead of only waiting).
+ * parallelForDynamic() does the same with small fixed-size chunks, so a
+ * thread that finishes early keeps taking work from slower ones.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping;
+
+    void enqueue(std::function<void()> task);
+    void workerLoop();
+    void runChunks(size_t count, size_t chunkSize,
+                   const std::function<void(size_t, size_t)>& body);
+
+public:
+    // Start threadCount workers (0 = one per hardware thread)
+    explicit ThreadPool(size_t threadCount = 0);
+
+    // Destructor - finishes queued tasks, then joins the workers
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Process-wide pool sized to the machine
+    static ThreadPool& shared();
+
+    size_t getThreadCount() const;
+
+    // Queue a task; exceptions are delivered through the future
+    template <typename F>
+    std::future<std::invoke_result_t<F>> submit(F&& task) {
+        using Result = std::invoke_result_t<F>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> result = packaged->get_future();
+        enqueue([packaged]() { (*packaged)(); });
+        return result;
+    }
+
+    // Run body(begin, end) over [0, count) in chunks of at least minChunk
+    // indices and wait for all of them; the first exception is rethrown
+    void parallelFor(size_t count, size_t minChunk,
+                     const std::function<void(size_t, size_t)>& body);
+
+    // Run body(begin, end) over [0, count) in chunks of exactly chunkSize
+    // indices (the last may be shorter), claimed one at a time. For work
+    // whose cost per index varies widely; otherwise prefer parallelFor
+    void parallelForDynamic(size_t count, size_t chunkSize,
+                            const std::function<void(size_t, size_t)>& body);
+};
@@ -1,7 +1,8 @@
 #include "Timestamp.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <ctime>
-#include <sstream>
-#include <iomanip>
 
 // Default constructor - current time
 Timestamp::Timestamp() : timePoint(std::chrono::system_clock::now()) {
@@ -40,86 +41,173 @@ Timestamp Timestamp::fromTimeT(std::time_t time) {
     return Timestamp(std::chrono::system_clock::from_time_t(time));
 }
 
+// ===== Civil time helpers =====
+
+namespace {
+
+// Direct-mapped cache of UTC offsets, one entry per UTC hour. Each entry
+// packs the hour index (top bit set to mark the entry valid) in the high
+// 32 bits and the offset in the low 32, so a lookup is one atomic load.
+const std::size_t OFFSET_CACHE_SIZE = 256;
+std::atomic<std::uint64_t> offsetCache[OFFSET_CACHE_SIZE];
+
+// Floor division for possibly negative values
+std::int64_t floorDiv(std::int64_t a, std::int64_t b) {
+    return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+}
+
+// Howard Hinnant's civil_from_days: days since 1970-01-01 -> y/m/d
+void civilFromDays(std::int64_t days, int& year, int& month, int& day) {
+    days += 719468;
+    std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    unsigned doe = static_cast<unsigned>(days - era * 146097);               // [0, 146096]
+    unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;   // [0, 399]
+    unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);                 // [0, 365]
+    unsigned mp = (5 * doy + 2) / 153;                                      // [0, 11]
+    day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+    month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    year = static_cast<int>(yoe + era * 400 + (month <= 2));
+}
+
+// Two-digit lookup table: "00" "01" ... "99"
+const char DIGIT_PAIRS[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+char* writeTwoDigits(char* p, int value) {
+    std::memcpy(p, DIGIT_PAIRS + value * 2, 2);
+    return p + 2;
+}
+
+// "YYYY-MM-DD"; years outside 0..9999 are clamped to keep the fixed width
+char* writeDate(char* p, const CivilTime& civil) {
+    int year = civil.year < 0 ? 0 : (civil.year > 9999 ? 9999 : civil.year);
+    p = writeTwoDigits(p, year / 100);
+    p = writeTwoDigits(p, year % 100);
+    *p++ = '-';
+    p = writeTwoDigits(p, civil.month);
+    *p++ = '-';
+    return writeTwoDigits(p, civil.day);
+}
+
+// "HH:MM:SS"
+char* writeTime(char* p, const CivilTime& civil) {
+    p = writeTwoDigits(p, civil.hour);
+    *p++ = ':';
+    p = writeTwoDigits(p, civil.minute);
+    *p++ = ':';
+    return writeTwoDigits(p, civil.second);
+}
+
+}  // namespace
+
+// Local UTC offset, cached per UTC hour
+long Timestamp::utcOffsetAt(std::time_t time) {
+    std::int64_t hour = floorDiv(static_cast<std::int64_t>(time), 3600);
+    std::uint64_t tag = static_cast<std::uint64_t>(static_cast<std::uint32_t>(hour) | 0x80000000u) << 32;
+    std::atomic<std::uint64_t>& entry =
+        offsetCache[static_cast<std::uint64_t>(hour) % OFFSET_CACHE_SIZE];
+
+    std::uint64_t cached = entry.load(std::memory_order_relaxed);
+    if ((cached & 0xFFFFFFFF00000000ULL) == tag) {
+        return static_cast<std::int32_t>(static_cast<std::uint32_t>(cached));
+    }
+
+    std::tm local;
+    localtime_r(&time, &local);
+    long offset = local.tm_gmtoff;
+
+    // Only cache hours with no offset change inside them (DST switches
+    // normally happen on the hour, so that is almost every hour)
+    std::time_t hourStart = static_cast<std::time_t>(hour * 3600);
+    std::time_t hourEnd = hourStart + 3599;
+    std::tm startTm;
+    std::tm endTm;
+    localtime_r(&hourStart, &startTm);
+    localtime_r(&hourEnd, &endTm);
+    if (startTm.tm_gmtoff == offset && endTm.tm_gmtoff == offset) {
+        entry.store(tag | static_cast<std::uint32_t>(static_cast<std::int32_t>(offset)),
+                    std::memory_order_relaxed);
+    }
+    return offset;
+}
+
+// Decompose into local calendar fields
+CivilTime Timestamp::decompose() const {
+    std::int64_t seconds = std::chrono::duration_cast<std::chrono::seconds>(
+        timePoint.time_since_epoch()).count();
+    // Round toward negative infinity like to_time_t on sub-second times
+    if (timePoint.time_since_epoch() < std::chrono::seconds(seconds)) {
+        --seconds;
+    }
+
+    std::int64_t localSeconds = seconds + utcOffsetAt(static_cast<std::time_t>(seconds));
+    std::int64_t days = floorDiv(localSeconds, 86400);
+    int secondOfDay = static_cast<int>(localSeconds - days * 86400);
+
+    CivilTime civil;
+    civilFromDays(days, civil.year, civil.month, civil.day);
+    civil.hour = secondOfDay / 3600;
+    civil.minute = (secondOfDay / 60) % 60;
+    civil.second = secondOfDay % 60;
+    return civil;
+}
+
 // Get individual components
 int Timestamp::getYear() const {
-    std::time_t time = std::chrono::system_clock::to_time_t(timePoint);
-    std::tm* local = std::localtime(&time);
-    return local->tm_year + 1900;
+    return decompose().year;
 }
 
 int Timestamp::getMonth() const {
-    std::time_t time = std::chrono::system_clock::to_time_t(timePoint);
-    std::tm* local = std::localtime(&time);
-    return local->tm_mon + 1;
+    return decompose().month;
 }
 
 int Timestamp::getDay() const {
-    std::time_t time = std::chrono::system_clock::to_time_t(timePoint);
-    std::tm* local = std::localtime(&time);
-    return local->tm_mday;
+    return decompose().day;
 }
 
 int Timestamp::getHour() const {
-    std::time_t time = std::chrono::system_clock::to_time_t(timePoint);
-    std::tm* local = std::localtime(&time);
-    return local->tm_hour;
+    return decompose().hour;
 }
 
 int Timestamp::getMinute() const {
-    std::time_t time = std::chrono::system_clock::to_time_t(timePoint);
-    std::tm* local = std::localtime(&time);
-    return local->tm_min;
+    return decompose().minute;
 }
 
 int Timestamp::getSecond() const {
-    std::time_t time = std::chrono::system_clock::to_time_t(timePoint);
-    std::tm* local = std::localtime(&time);
-    return local->tm_sec;
+    return decompose().second;
+}
+
+// Format into a caller buffer: "YYYY-MM-DD HH:MM:SS"
+char* Timestamp::toChars(char* first, char* last) const {
+    if (static_cast<std::size_t>(last - first) < MAX_CHARS) {
+        return nullptr;
+    }
+    CivilTime civil = decompose();
+    char* p = writeDate(first, civil);
+    *p++ = ' ';
+    return writeTime(p, civil);
 }
 
 // Format as string: "YYYY-MM-DD HH:MM:SS"
 std::string Timestamp::toString() const {
-    std::time_t time = std::chrono::system_clock::to_time_t(timePoint);
-    std::tm* local = std::localtime(&time);
-
-    std::stringstream ss;
-    ss << std::setfill('0')
-       << std::setw(4) << (local->tm_year + 1900) << "-"
-       << std::setw(2) << (local->tm_mon + 1) << "-"
-       << std::setw(2) << local->tm_mday << " "
-       << std::setw(2) << local->tm_hour << ":"
-       << std::setw(2) << local->tm_min << ":"
-       << std::setw(2) << local->tm_sec;
-
-    return ss.str();
+    char buffer[MAX_CHARS];
+    return std::string(buffer, toChars(buffer, buffer + MAX_CHARS));
 }
 
 // Format as date string: "YYYY-MM-DD"
 std::string Timestamp::toDateString() const {
-    std::time_t time = std::chrono::system_clock::to_time_t(timePoint);
-    std::tm* local = std::localtime(&time);
-
-    std::stringstream ss;
-    ss << std::setfill('0')
-       << std::setw(4) << (local->tm_year + 1900) << "-"
-       << std::setw(2) << (local->tm_mon + 1) << "-"
-       << std::setw(2) << local->tm_mday;
-
-    return ss.str();
+    char buffer[MAX_CHARS];
+    char* end = writeDate(buffer, decompose());
+    return std::string(buffer, end);
 }
 
 // Format as time string: "HH:MM:SS"
 std::string Timestamp::toTimeString() const {
-    std::time_t time = std::chrono::system_clock::to_time_t(timePoint);
-    std::tm* local = std::localtime(&time);
-
-    std::stringstream ss;
-    ss << std::setfill('0')
-       << std::setw(2) << local->tm_hour << ":"
-       << std::setw(2) << local->tm_min << ":"
-       << std::setw(2) << local->tm_sec;
-
-    return ss.str();
+    char buffer[MAX_CHARS];
+    char* end = writeTime(buffer, decompose());
+    return std::string(buffer, end);
 }
 
 // Calculate days since another timestamp
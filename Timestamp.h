@@ -2,8 +2,22 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
+#include <ctime>
 #include <string>
 
+/**
+ * CivilTime - Local calendar date and wall-clock time of a Timestamp
+ */
+struct CivilTime {
+    int year;
+    int month;      // 1-12
+    int day;        // 1-31
+    int hour;
+    int minute;
+    int second;
+};
+
 /**
  * Timestamp - Class is used as a convenient wrapper around std::chrono for banking system
  */
@@ -11,7 +25,13 @@ class Timestamp {
 private:
     std::chrono::system_clock::time_point timePoint;
 
+    // Local UTC offset in seconds at the given time (cached per hour)
+    static long utcOffsetAt(std::time_t time);
+
 public:
+    // Length of "YYYY-MM-DD HH:MM:SS"
+    static constexpr std::size_t MAX_CHARS = 19;
+
     // Constructors
     Timestamp();  // Current time
     explicit Timestamp(std::chrono::system_clock::time_point tp);
@@ -24,6 +44,10 @@ public:
     static Timestamp now();
     static Timestamp fromTimeT(std::time_t time);
 
+    // All local date/time fields at once; reentrant, no localtime() call
+    // on the common path
+    CivilTime decompose() const;
+
     // Getters for individual components
     int getYear() const;
     int getMonth() const;
@@ -33,6 +57,9 @@ public:
     int getSecond() const;
 
     // Formatting
+    // Write "YYYY-MM-DD HH:MM:SS" into [first, last) without allocating;
+    // returns one past the last character, or nullptr if it does not fit
+    char* toChars(char* first, char* last) const;
     std::string toString() const;  // Format: "YYYY-MM-DD HH:MM:SS"
     std::string toDateString() const;  // Format: "YYYY-MM-DD"
     std::string toTimeString() const;  // Format: "HH:MM:SS"
@@ -1,15 +1,27 @@
 #include "Transaction.h"
+#include "Account.h"
+#include "OutputBuffer.h"
 #include <iostream>
-#include <sstream>
 
 // Constructor
-Transaction::Transaction(const std::string& transactionId, const Timestamp& timestamp,
+Transaction::Transaction(const char* idPrefix, const Timestamp& timestamp,
                          const std::string& description)
-    : transactionId(transactionId), timestamp(timestamp), description(description) {
+    : idPrefix(idPrefix), transactionId(TransactionIdGenerator::next()),
+      timestamp(timestamp), description(description),
+      journal(nullptr), journalLsn(0) {
 }
 
 // Getters
 std::string Transaction::getId() const {
+    std::string id(idPrefix);
+    id += '-';
+    char buffer[TransactionId::MAX_CHARS];
+    char* end = transactionId.toChars(buffer, buffer + sizeof(buffer));
+    id.append(buffer, end);
+    return id;
+}
+
+TransactionId Transaction::getTransactionId() const {
     return transactionId;
 }
 
@@ -21,17 +33,86 @@ std::string Transaction::getDescription() const {
     return description;
 }
 
+// Attach write-ahead journal
+void Transaction::attachJournal(TransactionJournal* journal) {
+    this->journal = journal;
+}
+
+std::uint64_t Transaction::getJournalLsn() const {
+    return journalLsn;
+}
+
+// Add to account history and append to journal if one is attached
+void Transaction::recordPosting(TransactionId id, TransactionJournal::RecordType type,
+                                Account& account, Money amount, Account* target) {
+    std::int64_t timeMicros = HistoryEntry::toMicros(timestamp);
+
+    HistoryEntry entry;
+    entry.id = id;
+    entry.timeMicros = timeMicros;
+    entry.amount = amount;
+    entry.balanceAfter = account.getBalance();
+    if (type == TransactionJournal::RecordType::Deposit) {
+        entry.kind = HistoryEntry::Kind::Deposit;
+    } else if (type == TransactionJournal::RecordType::Withdraw) {
+        entry.kind = HistoryEntry::Kind::Withdraw;
+    } else {
+        entry.kind = HistoryEntry::Kind::TransferOut;
+    }
+    if (target != nullptr) {
+        entry.counterparty = target->getAccountHandle();
+    }
+    account.recordHistory(entry);
+
+    if (target != nullptr) {
+        entry.kind = HistoryEntry::Kind::TransferIn;
+        entry.balanceAfter = target->getBalance();
+        entry.counterparty = account.getAccountHandle();
+        target->recordHistory(entry);
+    }
+
+    if (journal == nullptr) {
+        return;
+    }
+
+    TransactionJournal::Record record;
+    record.type = type;
+    record.accountNo = account.getAccountNo();
+    record.amount = amount;
+    record.balanceAfter = account.getBalance();
+    if (target != nullptr) {
+        record.otherId = target->getAccountNo();
+        record.otherBalanceAfter = target->getBalance();
+    }
+    record.timeMicros = timeMicros;
+    record.transactionId = id.getValue();
+    journalLsn = journal->append(record);
+}
+
+// Append the common part of the record
+void Transaction::formatTo(OutputBuffer& out) const {
+    out.append("Transaction ID: ");
+    out.append(idPrefix);
+    out.put('-');
+    out.appendChars(transactionId);
+    out.append("\nTimestamp: ");
+    out.appendChars(timestamp);
+    out.append("\nDescription: ");
+    out.append(description);
+}
+
 // Create a record of the transaction
 std::string Transaction::record() const {
-    std::stringstream ss;
-    ss << "Transaction ID: " << transactionId << "\n";
-    ss << "Timestamp: " << timestamp.toString() << "\n";
-    ss << "Description: " << description;
-    return ss.str();
+    OutputBuffer out(256);
+    formatTo(out);
+    return std::string(out.view());
 }
 
 // Display transaction details
 void Transaction::display() const {
-    std::cout << "=== Transaction ===" << std::endl;
-    std::cout << record() << std::endl;
+    OutputBuffer out(256);
+    out.append("=== Transaction ===\n");
+    formatTo(out);
+    out.put('\n');
+    std::cout << out.view() << std::flush;
 }
\ No newline at end of file
@@ -1,6 +1,12 @@
 #pragma once
 #include<string>
+#include <cstdint>
 #include "Timestamp.h"
+#include "TransactionId.h"
+#include "TransactionJournal.h"
+
+class Account;
+class OutputBuffer;
 
 /**
  * Abstract base class for all banking transactions
@@ -8,28 +14,51 @@
  */
 class Transaction {
 protected:
-    std::string transactionId;
+    const char* idPrefix;           // Kind tag for the readable id, e.g. "DEP"
+    TransactionId transactionId;    // Assigned from TransactionIdGenerator
     Timestamp timestamp;
     std::string description;
 
+    // Optional write-ahead journal (nullptr when journaling is off)
+    TransactionJournal* journal;
+    std::uint64_t journalLsn;
+
+    // Record an applied posting: add it to the history of account (and
+    // target for transfers) and append the after-image to the journal.
+    // Subclasses call this from execute/undo while holding the account
+    // locks so journal and history order match apply order. Reversals pass
+    // a fresh id, so every history entry has its own.
+    void recordPosting(TransactionId id, TransactionJournal::RecordType type, Account& account,
+                       Money amount, Account* target = nullptr);
+
 public:
-    Transaction(const std::string& transactionId, const Timestamp& timestamp,
+    Transaction(const char* idPrefix, const Timestamp& timestamp,
                 const std::string& description);
 
     // Virtual destructor
     virtual ~Transaction() = default;
 
     // Getters
+    // Readable id ("DEP-<number>"), rendered on demand
     std::string getId() const;
+    TransactionId getTransactionId() const;
     Timestamp getTimestamp() const;
     std::string getDescription() const;
 
+    // Journal this transaction when it executes; after execute() the caller
+    // waits for durability with journal->commit(getJournalLsn())
+    void attachJournal(TransactionJournal* journal);
+    std::uint64_t getJournalLsn() const;
+
     // Pure virtual methods - must be implemented by subclasses
     virtual bool execute() = 0;
     virtual bool undo() = 0;
 
-    // Transaction records (for history/logging)
-    virtual std::string record() const;
+    // Transaction records (for history/logging). formatTo appends the
+    // record to a caller's buffer without allocating; subclasses extend it.
+    // record() is the same text as a string
+    virtual void formatTo(OutputBuffer& out) const;
+    std::string record() const;
 
     // Display transaction details
     virtual void display() const;
@@ -0,0 +1,82 @@
+#include "TransactionId.h"
+#include <charconv>
+#include <chrono>
+#include <stdexcept>
+
+static constexpr std::uint64_t SEQUENCE_MASK = (1ULL << TransactionId::SEQUENCE_BITS) - 1;
+static constexpr std::uint64_t NODE_MASK = (1ULL << TransactionId::NODE_BITS) - 1;
+static constexpr int TIME_SHIFT = TransactionId::SEQUENCE_BITS + TransactionId::NODE_BITS;
+
+// ===== TransactionId =====
+
+std::int64_t TransactionId::getUnixMillis() const {
+    return static_cast<std::int64_t>(value >> TIME_SHIFT) + EPOCH_MILLIS;
+}
+
+unsigned TransactionId::getNode() const {
+    return static_cast<unsigned>((value >> SEQUENCE_BITS) & NODE_MASK);
+}
+
+unsigned TransactionId::getSequence() const {
+    return static_cast<unsigned>(value & SEQUENCE_MASK);
+}
+
+char* TransactionId::toChars(char* first, char* last) const {
+    auto result = std::to_chars(first, last, value);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+std::string TransactionId::toString() const {
+    char buffer[MAX_CHARS];
+    char* end = toChars(buffer, buffer + MAX_CHARS);
+    return std::string(buffer, end);
+}
+
+// ===== TransactionIdGenerator =====
+
+std::atomic<std::uint64_t> TransactionIdGenerator::lastId{0};
+std::atomic<unsigned> TransactionIdGenerator::nodeId{0};
+
+TransactionId TransactionIdGenerator::next() {
+    std::int64_t millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count() - TransactionId::EPOCH_MILLIS;
+    std::uint64_t node = nodeId.load(std::memory_order_relaxed);
+    std::uint64_t fromClock = (static_cast<std::uint64_t>(millis < 0 ? 0 : millis) << TIME_SHIFT) |
+                              (node << TransactionId::SEQUENCE_BITS);
+
+    std::uint64_t last = lastId.load(std::memory_order_relaxed);
+    for (;;) {
+        // Same millisecond (or clock behind): bump the sequence; when it
+        // overflows, move on to the next millisecond instead of the node bits
+        std::uint64_t candidate = fromClock;
+        if (candidate <= last) {
+            candidate = last + 1;
+            if (((candidate >> TransactionId::SEQUENCE_BITS) & NODE_MASK) != node) {
+                candidate = (((last >> TIME_SHIFT) + 1) << TIME_SHIFT) |
+                            (node << TransactionId::SEQUENCE_BITS);
+            }
+        }
+        if (lastId.compare_exchange_weak(last, candidate, std::memory_order_relaxed)) {
+            return TransactionId(candidate);
+        }
+    }
+}
+
+void TransactionIdGenerator::observe(TransactionId id) {
+    std::uint64_t last = lastId.load(std::memory_order_relaxed);
+    while (last < id.getValue() &&
+           !lastId.compare_exchange_weak(last, id.getValue(), std::memory_order_relaxed)) {
+        // last reloaded by compare_exchange_weak; retry
+    }
+}
+
+void TransactionIdGenerator::setNodeId(unsigned node) {
+    if (node > NODE_MASK) {
+        throw std::invalid_argument("Transaction node id must be between 0 and 1023");
+    }
+    nodeId.store(node, std::memory_order_relaxed);
+}
+
+unsigned TransactionIdGenerator::getNodeId() {
+    return nodeId.load(std::memory_order_relaxed);
+}
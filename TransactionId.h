@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * TransactionId - 64-bit, time-ordered transaction identifier
+ *
+ * Snowflake layout (most to least significant):
+ *   41 bits  milliseconds since 2024-01-01 UTC
+ *   10 bits  node id (one per process writing the same ledger)
+ *   12 bits  sequence within the millisecond
+ * Comparing two ids orders them by creation time.
+ */
+class TransactionId {
+private:
+    std::uint64_t value;
+
+public:
+    static constexpr int SEQUENCE_BITS = 12;
+    static constexpr int NODE_BITS = 10;
+    static constexpr std::int64_t EPOCH_MILLIS = 1704067200000LL;  // 2024-01-01T00:00:00Z
+
+    // Longest rendered id: 20 decimal digits
+    static constexpr std::size_t MAX_CHARS = 20;
+
+    constexpr TransactionId() : value(0) {}
+    constexpr explicit TransactionId(std::uint64_t value) : value(value) {}
+
+    constexpr std::uint64_t getValue() const { return value; }
+    constexpr bool isValid() const { return value != 0; }
+
+    // Decoded fields
+    std::int64_t getUnixMillis() const;
+    unsigned getNode() const;
+    unsigned getSequence() const;
+
+    // Decimal form; writes into [first, last) and returns one past the end,
+    // or nullptr if the buffer is too small
+    char* toChars(char* first, char* last) const;
+    std::string toString() const;
+
+    constexpr bool operator<(TransactionId other) const { return value < other.value; }
+    constexpr bool operator==(TransactionId other) const { return value == other.value; }
+    constexpr bool operator!=(TransactionId other) const { return value != other.value; }
+};
+
+/**
+ * TransactionIdGenerator - Lock-free source of unique, increasing ids
+ *
+ * A single compare-and-swap per id. When more than 4096 ids are requested
+ * within one millisecond (or the clock steps backwards) the sequence simply
+ * carries into the time field, so ids stay unique and monotonic.
+ */
+class TransactionIdGenerator {
+private:
+    static std::atomic<std::uint64_t> lastId;
+    static std::atomic<unsigned> nodeId;
+
+public:
+    // Next id for this process
+    static TransactionId next();
+
+    // Issue only ids above id from now on. Called for every id loaded at
+    // startup, so a clock that is behind cannot sort new postings before
+    // saved ones
+    static void observe(TransactionId id);
+
+    // Node id folded into new ids (0..1023)
+    static void setNodeId(unsigned node);
+    static unsigned getNodeId();
+};
@@ -0,0 +1,455 @@
+#include "TransactionJournal.h"
+#include "AccountFactory.h"
+#include "AccountRepository.h"
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// File header identifying the journal format
+static const char JOURNAL_MAGIC[8] = {'B', 'A', 'N', 'K', 'J', 'N', 'L', '1'};
+
+// Each record is framed as: u32 payload length | u32 checksum | payload
+static const std::size_t FRAME_HEADER_SIZE = 8;
+
+// Largest payload we accept when reading (guards against garbage lengths)
+static const std::uint32_t MAX_PAYLOAD_SIZE = 1 << 20;
+
+// FNV-1a checksum over the payload
+static std::uint32_t checksum(const char* data, std::size_t size) {
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Binary helpers (native byte order; journals are not moved between hosts)
+template <typename T>
+static void put(std::vector<char>& out, T value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+static void putString(std::vector<char>& out, const std::string& str) {
+    put<std::uint16_t>(out, static_cast<std::uint16_t>(str.size()));
+    out.insert(out.end(), str.begin(), str.end());
+}
+
+template <typename T>
+static bool get(const char*& p, const char* end, T& value) {
+    if (static_cast<std::size_t>(end - p) < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+    return true;
+}
+
+static bool getString(const char*& p, const char* end, std::string& str) {
+    std::uint16_t length;
+    if (!get(p, end, length) || static_cast<std::size_t>(end - p) < length) {
+        return false;
+    }
+    str.assign(p, length);
+    p += length;
+    return true;
+}
+
+// Encode one record with its frame header onto the end of out
+static void encodeRecord(std::vector<char>& out, const TransactionJournal::Record& record) {
+    std::size_t frameStart = out.size();
+    out.resize(out.size() + FRAME_HEADER_SIZE);
+
+    put<std::uint8_t>(out, static_cast<std::uint8_t>(record.type));
+    put<std::uint8_t>(out, static_cast<std::uint8_t>(record.accountType));
+    put<std::int64_t>(out, record.amount.getCents());
+    put<std::int64_t>(out, record.balanceAfter.getCents());
+    put<std::int64_t>(out, record.otherBalanceAfter.getCents());
+    put<std::int64_t>(out, record.timeMicros);
+    putString(out, record.accountNo);
+    putString(out, record.otherId);
+    put<std::uint64_t>(out, record.transactionId);
+    if (record.type == TransactionJournal::RecordType::OpenAccount) {
+        put<std::int64_t>(out, record.overdraftLimit.getCents());
+        put<double>(out, record.interestRate);
+    }
+
+    std::size_t payloadStart = frameStart + FRAME_HEADER_SIZE;
+    std::uint32_t length = static_cast<std::uint32_t>(out.size() - payloadStart);
+    std::uint32_t sum = checksum(out.data() + payloadStart, length);
+    std::memcpy(out.data() + frameStart, &length, sizeof(length));
+    std::memcpy(out.data() + frameStart + sizeof(length), &sum, sizeof(sum));
+}
+
+// Decode one payload; returns false if it is malformed
+static bool decodeRecord(const char* p, const char* end, TransactionJournal::Record& record) {
+    std::uint8_t type, accountType;
+    std::int64_t amount, balanceAfter, otherBalanceAfter;
+
+    if (!get(p, end, type) || !get(p, end, accountType) ||
+        !get(p, end, amount) || !get(p, end, balanceAfter) ||
+        !get(p, end, otherBalanceAfter) || !get(p, end, record.timeMicros) ||
+        !getString(p, end, record.accountNo) || !getString(p, end, record.otherId)) {
+        return false;
+    }
+
+    record.type = static_cast<TransactionJournal::RecordType>(type);
+    record.accountType = static_cast<AccountType>(accountType);
+    record.amount = Money::fromCents(amount);
+    record.balanceAfter = Money::fromCents(balanceAfter);
+    record.otherBalanceAfter = Money::fromCents(otherBalanceAfter);
+
+    if (!get(p, end, record.transactionId)) {
+        return false;
+    }
+
+    if (record.type == TransactionJournal::RecordType::OpenAccount) {
+        std::int64_t overdraftLimit;
+        if (!get(p, end, overdraftLimit) || !get(p, end, record.interestRate)) {
+            return false;
+        }
+        record.overdraftLimit = Money::fromCents(overdraftLimit);
+    }
+    return p == end;
+}
+
+// Write the whole buffer, retrying on short writes
+static bool writeAll(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            return false;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+// Constructor
+TransactionJournal::TransactionJournal()
+    : fd(-1), appendedLsn(0), durableLsn(0), flushInProgress(false), writeFailed(false) {
+}
+
+// Destructor
+TransactionJournal::~TransactionJournal() {
+    close();
+}
+
+// Open (or create) the journal file
+bool TransactionJournal::open(const std::string& journalPath) {
+    close();
+    path = journalPath;
+
+    std::vector<char> contents;
+    std::size_t validEnd = 0;
+    if (!readAll(contents, validEnd)) {
+        return false;
+    }
+
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT, 0644);
+    if (fd < 0) {
+        std::cerr << "Failed to open journal: " << path << std::endl;
+        return false;
+    }
+
+    if (contents.empty()) {
+        // New journal - write the header
+        if (!writeAll(fd, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) || ::fsync(fd) != 0) {
+            std::cerr << "Failed to initialize journal: " << path << std::endl;
+            close();
+            return false;
+        }
+        validEnd = sizeof(JOURNAL_MAGIC);
+    } else if (validEnd < contents.size()) {
+        // Drop a torn record left by a crash mid-write
+        std::cerr << "Discarding " << (contents.size() - validEnd)
+                  << " bytes of incomplete journal data" << std::endl;
+        if (::ftruncate(fd, static_cast<off_t>(validEnd)) != 0 || ::fsync(fd) != 0) {
+            close();
+            return false;
+        }
+    }
+
+    ::lseek(fd, static_cast<off_t>(validEnd), SEEK_SET);
+    return true;
+}
+
+// Close the journal, flushing anything still buffered
+void TransactionJournal::close() {
+    if (fd < 0) {
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        flushed.wait(lock, [this] { return !flushInProgress; });
+        if (!pending.empty()) {
+            writeAll(fd, pending.data(), pending.size());
+            ::fsync(fd);
+            pending.clear();
+        }
+        durableLsn = appendedLsn;
+    }
+    flushed.notify_all();
+
+    ::close(fd);
+    fd = -1;
+}
+
+bool TransactionJournal::isOpen() const {
+    return fd >= 0;
+}
+
+// Read the file and find where the last complete record ends
+bool TransactionJournal::readAll(std::vector<char>& contents, std::size_t& validEnd) const {
+    contents.clear();
+    validEnd = 0;
+
+    int readFd = ::open(path.c_str(), O_RDONLY);
+    if (readFd < 0) {
+        return true;  // No journal yet
+    }
+
+    struct stat info;
+    if (::fstat(readFd, &info) != 0) {
+        ::close(readFd);
+        return false;
+    }
+
+    contents.resize(static_cast<std::size_t>(info.st_size));
+    std::size_t offset = 0;
+    while (offset < contents.size()) {
+        ssize_t n = ::read(readFd, contents.data() + offset, contents.size() - offset);
+        if (n <= 0) {
+            break;
+        }
+        offset += static_cast<std::size_t>(n);
+    }
+    ::close(readFd);
+    contents.resize(offset);
+
+    if (contents.empty()) {
+        return true;
+    }
+
+    if (contents.size() < sizeof(JOURNAL_MAGIC) ||
+        std::memcmp(contents.data(), JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0) {
+        std::cerr << "Invalid journal file format: " << path << std::endl;
+        return false;
+    }
+
+    std::size_t pos = sizeof(JOURNAL_MAGIC);
+    while (contents.size() - pos >= FRAME_HEADER_SIZE) {
+        std::uint32_t length, sum;
+        std::memcpy(&length, contents.data() + pos, sizeof(length));
+        std::memcpy(&sum, contents.data() + pos + sizeof(length), sizeof(sum));
+
+        std::size_t payload = pos + FRAME_HEADER_SIZE;
+        if (length > MAX_PAYLOAD_SIZE || contents.size() - payload < length ||
+            checksum(contents.data() + payload, length) != sum) {
+            break;
+        }
+        pos = payload + length;
+    }
+
+    validEnd = pos;
+    return true;
+}
+
+static Timestamp timestampFromMicros(std::int64_t micros) {
+    return Timestamp(std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::microseconds(micros))));
+}
+
+// Re-create the history entries of a journaled posting that are newer than
+// the account's saved history (ids increase, so older ones are already there)
+static void replayHistory(const TransactionJournal::Record& record, Account& account,
+                          Account* target) {
+    TransactionId id(record.transactionId);
+    if (!id.isValid()) {
+        return;
+    }
+    TransactionIdGenerator::observe(id);
+
+    HistoryEntry entry;
+    entry.id = id;
+    entry.timeMicros = record.timeMicros;
+    entry.amount = record.amount;
+    entry.balanceAfter = record.balanceAfter;
+    switch (record.type) {
+        case TransactionJournal::RecordType::Deposit:
+            entry.kind = HistoryEntry::Kind::Deposit;
+            break;
+        case TransactionJournal::RecordType::Withdraw:
+            entry.kind = HistoryEntry::Kind::Withdraw;
+            break;
+        case TransactionJournal::RecordType::Interest:
+            entry.kind = HistoryEntry::Kind::Interest;
+            break;
+        default:
+            entry.kind = HistoryEntry::Kind::TransferOut;
+            break;
+    }
+    if (target != nullptr) {
+        entry.counterparty = target->getAccountHandle();
+    }
+    if (account.getLastHistoryId() < id) {
+        account.recordHistory(entry);
+    }
+
+    if (target != nullptr && target->getLastHistoryId() < id) {
+        entry.kind = HistoryEntry::Kind::TransferIn;
+        entry.balanceAfter = record.otherBalanceAfter;
+        entry.counterparty = account.getAccountHandle();
+        target->recordHistory(entry);
+    }
+}
+
+// Re-apply journaled postings
+size_t TransactionJournal::replay(AccountRepository& repository, AccountFactory& factory) {
+    std::vector<char> contents;
+    std::size_t validEnd = 0;
+    if (!readAll(contents, validEnd) || contents.empty()) {
+        return 0;
+    }
+
+    size_t applied = 0;
+    std::size_t pos = sizeof(JOURNAL_MAGIC);
+    while (pos < validEnd) {
+        std::uint32_t length;
+        std::memcpy(&length, contents.data() + pos, sizeof(length));
+        const char* payload = contents.data() + pos + FRAME_HEADER_SIZE;
+        pos += FRAME_HEADER_SIZE + length;
+
+        Record record;
+        if (!decodeRecord(payload, payload + length, record)) {
+            std::cerr << "Skipping malformed journal record" << std::endl;
+            continue;
+        }
+
+        if (record.type == RecordType::OpenAccount) {
+            if (repository.existsAccountNo(record.accountNo)) {
+                continue;  // Already in the snapshot
+            }
+
+            Account* account = factory.restore(record.accountType, record.accountNo, record.otherId,
+                                               record.balanceAfter, record.overdraftLimit,
+                                               record.interestRate);
+            if (account != nullptr) {
+                repository.save(account);
+                applied++;
+            }
+            continue;
+        }
+
+        if (record.type == RecordType::CloseAccount) {
+            if (repository.existsAccountNo(record.accountNo) &&
+                repository.remove(record.accountNo)) {
+                applied++;
+            }
+            continue;
+        }
+
+        auto account = repository.getByAccountNo(record.accountNo);
+        if (!account.has_value()) {
+            std::cerr << "Journal refers to unknown account: " << record.accountNo << std::endl;
+            continue;
+        }
+        account.value()->restoreBalance(record.balanceAfter);
+
+        // Without the accrual time the next run would pay the period again
+        if (record.type == RecordType::Interest) {
+            Timestamp accruedTo = timestampFromMicros(record.timeMicros);
+            if (account.value()->getLastInterestApplied() < accruedTo) {
+                account.value()->restoreLastInterestApplied(accruedTo);
+            }
+        }
+
+        Account* target = nullptr;
+        if (record.type == RecordType::Transfer) {
+            auto found = repository.getByAccountNo(record.otherId);
+            if (found.has_value()) {
+                target = found.value();
+                target->restoreBalance(record.otherBalanceAfter);
+            }
+        }
+        replayHistory(record, *account.value(), target);
+        applied++;
+    }
+
+    return applied;
+}
+
+// Buffer a record for the next group commit
+std::uint64_t TransactionJournal::append(const Record& record) {
+    std::lock_guard<std::mutex> lock(mutex);
+    encodeRecord(pending, record);
+    return ++appendedLsn;
+}
+
+// Wait until lsn is durable, leading a flush if nobody else is
+void TransactionJournal::commit(std::uint64_t lsn) {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (durableLsn < lsn) {
+        if (writeFailed) {
+            throw std::runtime_error("Journal is unusable after a failed write: " + path);
+        }
+
+        if (flushInProgress) {
+            // Another caller is writing; its batch may already include us
+            flushed.wait(lock);
+            continue;
+        }
+
+        if (fd < 0) {
+            throw std::runtime_error("Journal is not open: " + path);
+        }
+
+        // Become the leader: take everything appended so far
+        flushInProgress = true;
+        std::vector<char> batch;
+        batch.swap(pending);
+        std::uint64_t batchLsn = appendedLsn;
+
+        lock.unlock();
+        bool ok = writeAll(fd, batch.data(), batch.size()) && ::fdatasync(fd) == 0;
+        lock.lock();
+
+        flushInProgress = false;
+        writeFailed = !ok;
+        flushed.notify_all();
+
+        if (!ok) {
+            // Durability can no longer be guaranteed; do not retry the fsync
+            throw std::runtime_error("Failed to write journal: " + path);
+        }
+        durableLsn = batchLsn;
+    }
+}
+
+// Truncate the journal after a checkpoint
+bool TransactionJournal::reset() {
+    std::unique_lock<std::mutex> lock(mutex);
+    flushed.wait(lock, [this] { return !flushInProgress; });
+
+    if (fd < 0) {
+        return false;
+    }
+
+    pending.clear();
+    durableLsn = appendedLsn;
+
+    bool ok = ::ftruncate(fd, static_cast<off_t>(sizeof(JOURNAL_MAGIC))) == 0 &&
+              ::lseek(fd, static_cast<off_t>(sizeof(JOURNAL_MAGIC)), SEEK_SET) >= 0 &&
+              ::fsync(fd) == 0;
+    lock.unlock();
+    flushed.notify_all();
+    return ok;
+}
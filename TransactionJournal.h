@@ -0,0 +1,97 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "AccountType.h"
+#include "Money.h"
+
+class AccountFactory;
+class AccountRepository;
+
+/**
+ * TransactionJournal - Append-only write-ahead log of executed postings
+ *
+ * Every posting appends a binary record (while the account lock is still
+ * held, so journal order matches apply order) and the caller then waits in
+ * commit() until that record is on disk. Commits use group commit: the
+ * first waiter becomes the leader and writes + fsyncs everything appended
+ * so far, so concurrent posters share a single fsync.
+ *
+ * Records carry the after-image of each touched balance, which makes
+ * replay idempotent: replaying over a snapshot that already contains some
+ * of the postings yields the same balances. History entries are re-created
+ * only for postings newer than the account's saved history (by id).
+ */
+class TransactionJournal {
+public:
+    enum class RecordType : std::uint8_t {
+        Deposit = 1,
+        Withdraw = 2,
+        Transfer = 3,
+        Interest = 4,
+        OpenAccount = 5,
+        CloseAccount = 6
+    };
+
+    struct Record {
+        RecordType type = RecordType::Deposit;
+        AccountType accountType = AccountType::Savings;  // OpenAccount only
+        std::string accountNo;
+        std::string otherId;            // Transfer: target account, OpenAccount: owner id
+        Money amount;                   // Posting amount (audit only)
+        Money balanceAfter;             // Balance of accountNo after the posting
+        Money otherBalanceAfter;        // Transfer: balance of the target after the posting
+        std::int64_t timeMicros = 0;    // Microseconds since the Unix epoch (Interest: accrued to)
+        std::uint64_t transactionId = 0;  // History entry id of the posting (0 = none)
+        Money overdraftLimit;           // OpenAccount (chequing) only
+        double interestRate = 0.0;      // OpenAccount (savings) only
+    };
+
+private:
+    std::string path;
+    int fd;
+
+    std::mutex mutex;
+    std::condition_variable flushed;
+    std::vector<char> pending;      // Encoded records not yet written
+    std::uint64_t appendedLsn;      // Sequence number of the last appended record
+    std::uint64_t durableLsn;       // Sequence number of the last fsynced record
+    bool flushInProgress;
+    bool writeFailed;               // Sticky: set once a flush fails
+
+    // Read and validate the whole file; returns the offset of the valid end
+    bool readAll(std::vector<char>& contents, std::size_t& validEnd) const;
+
+public:
+    // Constructor
+    TransactionJournal();
+
+    // Destructor - flushes pending records and closes the file
+    ~TransactionJournal();
+
+    TransactionJournal(const TransactionJournal&) = delete;
+    TransactionJournal& operator=(const TransactionJournal&) = delete;
+
+    // Open (or create) the journal file; a torn record at the tail left by
+    // a crash is discarded
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+
+    // Re-apply all journaled postings to the repository; opened accounts
+    // are rebuilt through the factory. Returns the number of records applied
+    size_t replay(AccountRepository& repository, AccountFactory& factory);
+
+    // Buffer a record; returns its sequence number for commit()
+    std::uint64_t append(const Record& record);
+
+    // Block until the record with the given sequence number is durable
+    // Throws std::runtime_error if the journal cannot be written
+    void commit(std::uint64_t lsn);
+
+    // Discard all records once a snapshot covering them has been saved
+    bool reset();
+};
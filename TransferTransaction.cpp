@@ -1,27 +1,50 @@
 #include "TransferTransaction.h"
-#include <iostream>
-#include <sstream>
+#include "Logger.h"
+#include "OutputBuffer.h"
+#include <functional>
+#include <utility>
+
+// Lock both accounts in account handle order so that concurrent transfers
+// in opposite directions (A->B and B->A) cannot deadlock
+static std::pair<std::unique_lock<std::mutex>, std::unique_lock<std::mutex>>
+lockInOrder(Account& a, Account& b) {
+    if (&a == &b) {
+        return {std::unique_lock<std::mutex>(a.getMutex()), std::unique_lock<std::mutex>()};
+    }
+
+    bool aFirst = a.getAccountHandle() != b.getAccountHandle()
+                      ? a.getAccountHandle() < b.getAccountHandle()
+                      : std::less<const Account*>{}(&a, &b);
+    Account& first = aFirst ? a : b;
+    Account& second = aFirst ? b : a;
+
+    std::unique_lock<std::mutex> firstLock(first.getMutex());
+    std::unique_lock<std::mutex> secondLock(second.getMutex());
+    return {std::move(firstLock), std::move(secondLock)};
+}
 
 // Constructor
 TransferTransaction::TransferTransaction(Account& fromAccount, Account& toAccount,
-    double amount, const Timestamp& timestamp, const std::string& description) :
-        Transaction("TRF-" + fromAccount.getAccountNo() + "-" + toAccount.getAccountNo()
-            + "-" + timestamp.toString(), timestamp, description), fromAccount(fromAccount),
+    Money amount, const Timestamp& timestamp, const std::string& description) :
+        Transaction("TRF", timestamp, description), fromAccount(fromAccount),
                 toAccount(toAccount), amount(amount), executed(false) {
 }
 
 // Execute the transfer
 bool TransferTransaction::execute() {
+    auto locks = lockInOrder(fromAccount, toAccount);
+
     if (executed) {
-        std::cerr << "Transaction already executed!" << std::endl;
+        LOG_WARN("Transaction already executed!");
         return false;
     }
 
     if (fromAccount.transferTo(toAccount, amount)) {
         executed = true;
-        std::cout << "Transfer executed: $" << amount
-                  << " from " << fromAccount.getAccountNo()
-                  << " to " << toAccount.getAccountNo() << std::endl;
+        recordPosting(transactionId, TransactionJournal::RecordType::Transfer, fromAccount, amount,
+                      &toAccount);
+        LOG_DEBUG("Transfer executed: $", amount, " from ", fromAccount.getAccountNo(),
+                  " to ", toAccount.getAccountNo());
         return true;
     }
 
@@ -30,45 +53,49 @@ bool TransferTransaction::execute() {
 
 // Undo the transfer (transfer back)
 bool TransferTransaction::undo() {
+    auto locks = lockInOrder(fromAccount, toAccount);
+
     if (!executed) {
-        std::cerr << "Cannot undo: Transaction not executed!" << std::endl;
+        LOG_WARN("Cannot undo: Transaction not executed!");
         return false;
     }
 
     // Transfer back from toAccount to fromAccount
     if (toAccount.transferTo(fromAccount, amount)) {
         executed = false;
-        std::cout << "Transfer undone: $" << amount
-                  << " transferred back from " << toAccount.getAccountNo()
-                  << " to " << fromAccount.getAccountNo() << std::endl;
+        recordPosting(TransactionIdGenerator::next(), TransactionJournal::RecordType::Transfer,
+                      toAccount, amount, &fromAccount);
+        LOG_DEBUG("Transfer undone: $", amount, " transferred back from ", toAccount.getAccountNo(),
+                  " to ", fromAccount.getAccountNo());
         return true;
     }
 
-    std::cerr << "Failed to undo transfer - insufficient funds in target account" << std::endl;
+    LOG_WARN("Failed to undo transfer - insufficient funds in target account");
     return false;
 }
 
-// Create detailed record
-std::string TransferTransaction::record() const {
-    std::stringstream ss;
-    ss << Transaction::record() << "\n";
-    ss << "Type: Transfer\n";
-    ss << "From Account: " << fromAccount.getAccountNo() << "\n";
-    ss << "To Account: " << toAccount.getAccountNo() << "\n";
-    ss << "Amount: $" << amount << "\n";
-    ss << "Status: " << (executed ? "Executed" : "Not Executed");
-    return ss.str();
+// Append detailed record
+void TransferTransaction::formatTo(OutputBuffer& out) const {
+    Transaction::formatTo(out);
+    out.append("\nType: Transfer\nFrom Account: ");
+    out.append(fromAccount.getAccountNo());
+    out.append("\nTo Account: ");
+    out.append(toAccount.getAccountNo());
+    out.append("\nAmount: $");
+    out.appendChars(amount);
+    out.append("\nStatus: ");
+    out.append(executed ? "Executed" : "Not Executed");
 }
 
 // Getters
-double TransferTransaction::getAmount() const {
+Money TransferTransaction::getAmount() const {
     return amount;
 }
 
-std::string TransferTransaction::getFromAccountNo() const {
+const std::string& TransferTransaction::getFromAccountNo() const {
     return fromAccount.getAccountNo();
 }
 
-std::string TransferTransaction::getToAccountNo() const {
+const std::string& TransferTransaction::getToAccountNo() const {
     return toAccount.getAccountNo();
 }
\ No newline at end of file
@@ -11,23 +11,23 @@ class TransferTransaction : public Transaction {
 private:
     Account& fromAccount;
     Account& toAccount;
-    double amount;
+    Money amount;
     bool executed;  // Track if transaction has been executed
 
 public:
     // Constructor
-    TransferTransaction(Account& fromAccount, Account& toAccount, double amount,
+    TransferTransaction(Account& fromAccount, Account& toAccount, Money amount,
                        const Timestamp& timestamp, const std::string& description);
     
     // Implementation of pure virtual methods
     bool execute() override;
     bool undo() override;
     
-    // Override record to include transfer-specific details
-    std::string record() const override;
+    // Extend the record with transfer-specific details
+    void formatTo(OutputBuffer& out) const override;
     
     // Getters
-    double getAmount() const;
-    std::string getFromAccountNo() const;
-    std::string getToAccountNo() const;
+    Money getAmount() const;
+    const std::string& getFromAccountNo() const;
+    const std::string& getToAccountNo() const;
 };
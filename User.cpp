@@ -4,14 +4,15 @@
 
 // Default constructor
 User::User() : userId(""), name(""), email(""), passwordHash(""),
-               createdAt(Timestamp::now()), lastLogin(Timestamp::now()) {
+               createdAt(Timestamp::now()), lastLogin(Timestamp::now()),
+               dirty(true) {
 }
 
 // Parameterized constructor
 User::User(const std::string& userId, const std::string& name,
            const std::string& email, const std::string& passwordHash)
     : userId(userId), name(name), email(email), passwordHash(passwordHash),
-      createdAt(Timestamp::now()), lastLogin(Timestamp::now()) {
+      createdAt(Timestamp::now()), lastLogin(Timestamp::now()), dirty(true) {
 }
 
 // Getters
@@ -42,18 +43,35 @@ Timestamp User::getLastLogin() const {
 // Setters
 void User::setName(const std::string& name) {
     this->name = name;
+    dirty = true;
 }
 
 void User::setEmail(const std::string& email) {
     this->email = email;
+    dirty = true;
 }
 
 void User::setPasswordHash(const std::string& hash) {
     this->passwordHash = hash;
+    dirty = true;
 }
 
 void User::updateLastLogin() {
     this->lastLogin = Timestamp::now();
+    dirty = true;
+}
+
+// Dirty tracking
+bool User::isDirty() const {
+    return dirty;
+}
+
+void User::markDirty() {
+    dirty = true;
+}
+
+void User::clearDirty() {
+    dirty = false;
 }
 
 // Display info
@@ -15,6 +15,7 @@ private:
     std::string passwordHash;
     Timestamp createdAt;
     Timestamp lastLogin;
+    bool dirty;     // Changed since the last checkpoint
 
 public:
     // Constructors
@@ -36,6 +37,11 @@ public:
     void setPasswordHash(const std::string& hash);
     void updateLastLogin();
 
+    // Dirty tracking for incremental saves (see DataPersistence::checkpointUsers)
+    bool isDirty() const;
+    void markDirty();
+    void clearDirty();
+
     // Display
     void display() const;
 };
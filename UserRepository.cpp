@@ -1,5 +1,5 @@
 #include "UserRepository.h"
-#include <iostream>
+#include "Logger.h"
 
 // Constructor
 UserRepository::UserRepository() {
@@ -33,7 +33,7 @@ bool UserRepository::save(const User& user) {
     std::string userId = user.getUserId();
 
     if (userId.empty()) {
-        std::cerr << "Cannot save user with empty user ID" << std::endl;
+        LOG_WARN("Cannot save user with empty user ID");
         return false;
     }
 
@@ -41,12 +41,13 @@ bool UserRepository::save(const User& user) {
     if (users.find(userId) != users.end()) {
         // Update existing user
         users[userId] = user;
-        std::cout << "Updated existing user: " << userId << std::endl;
+        LOG_DEBUG("Updated existing user: ", userId);
     } else {
         // Add new user
         users[userId] = user;
-        std::cout << "Added new user: " << userId << std::endl;
+        LOG_DEBUG("Added new user: ", userId);
     }
+    users[userId].markDirty();
 
     return true;
 }
@@ -56,11 +57,12 @@ bool UserRepository::remove(const std::string& userId) {
     auto it = users.find(userId);
     if (it != users.end()) {
         users.erase(it);
-        std::cout << "Removed user: " << userId << std::endl;
+        removedUserIds.push_back(userId);
+        LOG_DEBUG("Removed user: ", userId);
         return true;
     }
 
-    std::cerr << "User not found: " << userId << std::endl;
+    LOG_DEBUG("User not found: ", userId);
     return false;
 }
 
@@ -83,6 +85,32 @@ size_t UserRepository::getUserCount() const {
     return users.size();
 }
 
+// Users changed since the last checkpoint
+std::vector<User*> UserRepository::getDirtyUsers() {
+    std::vector<User*> result;
+    for (auto& pair : users) {
+        if (pair.second.isDirty()) {
+            result.push_back(&pair.second);
+        }
+    }
+    return result;
+}
+
+// Removed IDs since the last checkpoint
+std::vector<std::string> UserRepository::takeRemovedUserIds() {
+    std::vector<std::string> result;
+    result.swap(removedUserIds);
+    return result;
+}
+
+// Forget pending changes
+void UserRepository::markClean() {
+    for (auto& pair : users) {
+        pair.second.clearDirty();
+    }
+    removedUserIds.clear();
+}
+
 // Clear all users
 void UserRepository::clear() {
     users.clear();
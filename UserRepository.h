@@ -15,6 +15,9 @@ private:
     // Storage: map of userId -> User
     std::map<std::string, User> users;
 
+    // IDs removed since the last checkpoint
+    std::vector<std::string> removedUserIds;
+
 public:
     // Constructor
     UserRepository();
@@ -40,9 +43,26 @@ public:
     // Get all users
     std::vector<User> getAllUsers() const;
 
+    // Call visit(const User&) for every user, in user ID order, without copying
+    template <typename F>
+    void forEachUser(F&& visit) const {
+        for (const auto& pair : users) {
+            visit(pair.second);
+        }
+    }
+
     // Get count of users
     size_t getUserCount() const;
 
+    // Users changed since the last checkpoint
+    std::vector<User*> getDirtyUsers();
+
+    // IDs removed since the last checkpoint; empties the list
+    std::vector<std::string> takeRemovedUserIds();
+
+    // Forget all pending changes (after a full save or load)
+    void markClean();
+
     // Clear all users
     void clear();
 };
@@ -1,26 +1,29 @@
 #include "WithdrawTransaction.h"
 
-#include <iostream>
-#include <sstream>
+#include "Logger.h"
+#include "OutputBuffer.h"
+#include <mutex>
 
 // Constructor
-WithdrawTransaction::WithdrawTransaction(Account& account, double amount,
+WithdrawTransaction::WithdrawTransaction(Account& account, Money amount,
     const Timestamp& timestamp, const std::string& description) :
-        Transaction("WTH-" + account.getAccountNo() + "-" + timestamp.toString(),
-            timestamp, description), account(account), amount(amount), executed(false) {
+        Transaction("WTH", timestamp, description), account(account), amount(amount),
+            executed(false) {
 }
 
 // Execute the withdrawal
 bool WithdrawTransaction::execute() {
+    std::lock_guard<std::mutex> lock(account.getMutex());
+
     if (executed) {
-        std::cerr << "Transaction already executed!" << std::endl;
+        LOG_WARN("Transaction already executed!");
         return false;
     }
 
     if (account.withdraw(amount)) {
         executed = true;
-        std::cout << "Withdrawal executed: $" << amount
-                  << " from account " << account.getAccountNo() << std::endl;
+        recordPosting(transactionId, TransactionJournal::RecordType::Withdraw, account, amount);
+        LOG_DEBUG("Withdrawal executed: $", amount, " from account ", account.getAccountNo());
         return true;
     }
 
@@ -29,37 +32,41 @@ bool WithdrawTransaction::execute() {
 
 // Undo the withdrawal (deposit the amount back)
 bool WithdrawTransaction::undo() {
+    std::lock_guard<std::mutex> lock(account.getMutex());
+
     if (!executed) {
-        std::cerr << "Cannot undo: Transaction not executed!" << std::endl;
+        LOG_WARN("Cannot undo: Transaction not executed!");
         return false;
     }
 
     if (account.deposit(amount)) {
         executed = false;
-        std::cout << "Withdrawal undone: $" << amount
-                  << " deposited back to account " << account.getAccountNo() << std::endl;
+        recordPosting(TransactionIdGenerator::next(), TransactionJournal::RecordType::Deposit,
+                      account, amount);
+        LOG_DEBUG("Withdrawal undone: $", amount, " deposited back to account ",
+                  account.getAccountNo());
         return true;
     }
 
     return false;
 }
 
-// Create record of transactions
-std::string WithdrawTransaction::record() const {
-    std::stringstream ss;
-    ss << Transaction::record() << "\n";
-    ss << "Type: Withdrawal\n";
-    ss << "Account: " << account.getAccountNo() << "\n";
-    ss << "Amount: $" << amount << "\n";
-    ss << "Status: " << (executed ? "Executed" : "Not Executed");
-    return ss.str();
+// Append record of transactions
+void WithdrawTransaction::formatTo(OutputBuffer& out) const {
+    Transaction::formatTo(out);
+    out.append("\nType: Withdrawal\nAccount: ");
+    out.append(account.getAccountNo());
+    out.append("\nAmount: $");
+    out.appendChars(amount);
+    out.append("\nStatus: ");
+    out.append(executed ? "Executed" : "Not Executed");
 }
 
 // Getters
-double WithdrawTransaction::getAmount() const {
+Money WithdrawTransaction::getAmount() const {
     return amount;
 }
 
-std::string WithdrawTransaction::getAccountNo() const {
+const std::string& WithdrawTransaction::getAccountNo() const {
     return account.getAccountNo();
 }
\ No newline at end of file
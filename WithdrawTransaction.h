@@ -10,22 +10,22 @@
 class WithdrawTransaction : public Transaction {
 private:
     Account& account;
-    double amount;
+    Money amount;
     bool executed;  // Track if transaction has been executed
 
 public:
     // Constructor
-    WithdrawTransaction(Account& account, double amount, const Timestamp& timestamp,
+    WithdrawTransaction(Account& account, Money amount, const Timestamp& timestamp,
                        const std::string& description);
 
     // Implementation of pure virtual methods
     bool execute() override;
     bool undo() override;
 
-    // Override record to include withdrawal-specific details
-    std::string record() const override;
+    // Extend the record with withdrawal-specific details
+    void formatTo(OutputBuffer& out) const override;
 
     // Getters
-    double getAmount() const;
-    std::string getAccountNo() const;
+    Money getAmount() const;
+    const std::string& getAccountNo() const;
 };
\ No newline at end of file
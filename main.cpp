@@ -7,6 +7,7 @@
 #include "UserRepository.h"
 #include "PasswordHasher.h"
 #include "DataPersistence.h"
+#include "TransactionJournal.h"
 
 /**
  * Banking System - Main Entry Point
@@ -19,7 +20,7 @@
  * - Interest calculation
  * - Transaction history
  * - Password security
- * - Data persistence (save/load)
+ * - Data persistence (snapshot + incremental deltas + write-ahead journal)
  * - User-friendly console interface
  */
 
@@ -37,10 +38,30 @@ int main() {
 
         // Initialize data persistence
         DataPersistence persistence("accounts.dat", "users.dat");
+        TransactionJournal journal;
 
-        // Load existing data
+        // Load existing data: latest snapshot, then postings journaled since
         std::cout << "Loading existing data..." << std::endl;
         persistence.loadAll(repository, userRepository, factory);
+        bank.setHistoryArchive(&persistence.getHistoryArchive());
+
+        if (journal.open("transactions.journal")) {
+            size_t replayed = journal.replay(repository, factory);
+            if (replayed > 0) {
+                std::cout << "Replayed " << replayed << " journaled postings" << std::endl;
+                factory.updateCounterFromLoadedAccounts(repository);
+
+                // Fold the replayed postings into the snapshot delta
+                if (persistence.checkpointAccounts(repository)) {
+                    journal.reset();
+                }
+            }
+            bank.setJournal(&journal);
+        } else {
+            std::cerr << "Warning: journaling disabled, changes are saved on exit only" << std::endl;
+        }
+        // Nothing else runs yet: free the accounts the load and replay removed
+        repository.reclaimRemoved();
         std::cout << std::endl;
 
         // Create a demo user for testing (only if no users exist)
@@ -49,9 +70,11 @@ int main() {
         if (auth.getUserCount() == 0) {
             std::cout << "Creating demo user..." << std::endl;
             auth.registerUser("demo", "Demo User", "demo@example.com", "demo123");
-            bank.createAccount("demo", AccountType::Savings, 1000.0);
-            bank.createAccount("demo", AccountType::Chequing, 500.0);
-            persistence.saveAll(repository, userRepository);
+            bank.createAccount("demo", AccountType::Savings, Money::fromUnits(1000));
+            bank.createAccount("demo", AccountType::Chequing, Money::fromUnits(500));
+            if (persistence.checkpointAll(repository, userRepository)) {
+                journal.reset();
+            }
             std::cout << std::endl;
         }
 
@@ -62,8 +85,11 @@ int main() {
 
         // Save data on exit
         std::cout << "\nSaving data..." << std::endl;
-        persistence.saveAll(repository, userRepository);
-        std::cout << "Data saved successfully." << std::endl;
+        if (persistence.checkpointAll(repository, userRepository)) {
+            // Snapshot plus delta now cover everything journaled
+            journal.reset();
+            std::cout << "Data saved successfully." << std::endl;
+        }
 
         return 0;
 